@@ -4,10 +4,17 @@
 #include <string.h>
 #include <time.h>
 #include <ctype.h>
+#include <stdarg.h>
 #ifdef _WIN32
     #include <windows.h>
 #else
     #include <unistd.h>
+    #include <pthread.h>
+#endif
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
 #endif
 
 #define MAX_NAME_LENGTH 50
@@ -15,10 +22,39 @@
 #define MAX_USERNAME_LENGTH 20
 #define MAX_PASSWORD_LENGTH 20
 #define MAX_DATE_LENGTH 30
+#define DATA_MAGIC 0x534D4153
+#define DATA_VERSION 5
+#define SHARD_PREFIX_LENGTH 8
+#define SHARD_PLAIN_PREFIX_LENGTH 4
+#define MANIFEST_FILE "manifest.dat"
+#define LEGACY_STUDENT_FILE "students.dat"
+#define MAX_WORKER_THREADS 64
+#define MIN_RECORDS_PER_WORKER 4096
+#define LOAD_CHUNK_RECORDS 1024
+#define DUE_BUCKET_COUNT 6
+#define POOL_CHUNK_NODES 1024
+#define POOL_HEADER_SIZE ((sizeof(PoolChunk) + 15) / 16 * 16)
+#define MALLOC_OVERHEAD (2 * sizeof(size_t))
+#define OUTPUT_BUFFER_SIZE (1 << 16)
+#define PAGE_SIZE 20
+#define SORT_BY_ID 1
+#define SORT_BY_NAME 2
+#define SORT_BY_DUE 3
+#define BLOOM_BITS_PER_KEY 10
+#define BLOOM_HASHES 7
+#define BLOOM_MIN_KEYS 1024
+#define SHARD_FILTER_MIN_KEYS 64
+#define ITERATOR_INITIAL_DEPTH 64
+#define HASH_MIN_CAPACITY 1024
+#define HASH_MAX_LOAD_PERCENT 70
+#define HASH_MIGRATE_STEP 64
+#define HASH_TOMBSTONE ((Student*)&hash_tombstone_marker)
+#define FUZZY_MAX_DISTANCE 3
+#define FUZZY_RESULT_LIMIT 10
 
 typedef struct PaymentNode {
     int semester;
-    float amount_paid;
+    int row;
     struct PaymentNode* next;
 } PaymentNode;
 
@@ -27,9 +63,10 @@ typedef struct Student {
     char name[MAX_NAME_LENGTH];
     char department[MAX_DEPT_LENGTH];
     float admission_fee_paid;
+    int payment_count;
     PaymentNode* payments;
-    char created_date[MAX_DATE_LENGTH];
-    char last_updated[MAX_DATE_LENGTH];
+    long long created_time;
+    long long updated_time;
     struct Student* left;
     struct Student* right;
 } Student;
@@ -42,7 +79,222 @@ typedef struct {
     char admin_password[MAX_PASSWORD_LENGTH];
 } AdminSettings;
 
+typedef struct PoolChunk {
+    struct PoolChunk* next;
+    size_t capacity;
+    size_t used;
+} PoolChunk;
+
+typedef struct {
+    size_t node_size;
+    PoolChunk* chunks;
+    void* free_list;
+    size_t live_nodes;
+    size_t total_nodes;
+    size_t chunk_count;
+} NodePool;
+
+typedef struct {
+    int payment_count;
+    long long amount_total;
+    int full_count;
+    int partial_count;
+} SemesterLedger;
+
+typedef struct {
+    char prefix[SHARD_PREFIX_LENGTH + 1];
+    int student_count;
+    int loaded;
+    int dirty;
+    unsigned char* filter;
+    size_t filter_bits;
+    SemesterLedger* ledger;
+    int ledger_capacity;
+} Shard;
+
+typedef struct {
+    int* semester;
+    long long* amount;
+    PaymentNode** owner;
+    size_t count;
+    size_t capacity;
+} PaymentColumns;
+
+typedef struct {
+    long long admission_paid;
+    long long tuition_paid;
+    int max_semester;
+    int department;
+} FeeSnapshot;
+
+typedef struct {
+    FeeSnapshot* records;
+    int count;
+    int capacity;
+    char (*departments)[MAX_DEPT_LENGTH];
+    int department_count;
+    int department_capacity;
+} FeeSnapshotSet;
+
+typedef struct {
+    Student** students;
+    FeeSnapshotSet snapshot;
+    int* department_map;
+    const FeeSnapshot* records;
+    int begin;
+    int end;
+    long long current_tuition;
+    long long current_admission;
+    long long tuition_fee;
+    long long admission_fee;
+    long long current_total;
+    long long projected_total;
+    long long* department_current;
+    long long* department_projected;
+    int due_buckets[DUE_BUCKET_COUNT];
+} FeeSimulationTask;
+
+typedef struct {
+    const char* data;
+    size_t size;
+    size_t offset;
+    int version;
+    int expected;
+    int parsed;
+    Student** run;
+    NodePool* students;
+    NodePool* payments;
+    NodePool local_students;
+    NodePool local_payments;
+    PaymentColumns* columns;
+    PaymentColumns local_columns;
+    SemesterLedger* ledger;
+    int ledger_capacity;
+} ParseTask;
+
+typedef struct {
+    long long* offsets;
+    int count;
+    int capacity;
+} ChunkIndex;
+
+typedef struct {
+    Student** stack;
+    int top;
+    int capacity;
+} StudentIterator;
+
+typedef struct {
+    char low[20];
+    char high[20];
+    int prefix_length;
+} IdRange;
+
+typedef void (*StudentVisitor)(Student* student, void* context);
+
+typedef struct {
+    StudentVisitor visit;
+    void* context;
+} VisitorBinding;
+
+typedef struct {
+    long long admission;
+    long long tuition;
+    int entries;
+    long long due;
+} PaymentTotals;
+
+typedef struct {
+    unsigned char* bits;
+    size_t bit_count;
+    int sized_for;
+    int keys;
+    int removed;
+    long long queries;
+    long long rejects;
+    long long false_positives;
+} BloomFilter;
+
+typedef struct {
+    unsigned long long hash;
+    Student* student;
+} HashSlot;
+
+typedef struct {
+    HashSlot* slots;
+    size_t capacity;
+    size_t live;
+} HashTable;
+
+typedef struct {
+    HashTable current;
+    HashTable draining;
+    size_t migrate_position;
+    long long resizes;
+} StudentIndex;
+
+typedef struct NameRef {
+    Student* student;
+    struct NameRef* next;
+} NameRef;
+
+typedef struct BKNode {
+    char key[MAX_NAME_LENGTH];
+    int distance;
+    struct BKNode* first_child;
+    struct BKNode* next_sibling;
+    NameRef* refs;
+} BKNode;
+
+typedef struct {
+    Student* student;
+    int distance;
+} FuzzyMatch;
+
+typedef struct {
+    Student** items;
+    int count;
+    int capacity;
+} StudentList;
+
+typedef struct {
+    Student* student;
+    long long due;
+} DueEntry;
+
+typedef struct {
+    FILE* file;
+    char* data;
+    size_t used;
+} OutputBuffer;
+
+typedef void (*WorkerFunc)(void* arg);
+
+typedef struct {
+    WorkerFunc func;
+    void* arg;
+} WorkerStart;
+
 Student* studentRoot = NULL;
+NodePool student_pool = {sizeof(Student), NULL, NULL, 0, 0, 0};
+NodePool payment_pool = {sizeof(PaymentNode), NULL, NULL, 0, 0, 0};
+Shard* shards = NULL;
+int shard_count = 0;
+int shard_capacity = 0;
+int* shard_slots = NULL;
+int shard_slot_capacity = 0;
+SemesterLedger* semester_ledger = NULL;
+PaymentColumns payment_columns = {NULL, NULL, NULL, 0, 0};
+BloomFilter student_bloom = {NULL, 0, 0, 0, 0, 0, 0, 0};
+StudentIndex student_index = {{NULL, 0, 0}, {NULL, 0, 0}, 0, 0};
+static char hash_tombstone_marker;
+BKNode* name_index_root = NULL;
+int name_index_dead_keys = 0;
+int name_index_built = 0;
+NodePool bk_node_pool = {sizeof(BKNode), NULL, NULL, 0, 0, 0};
+NodePool name_ref_pool = {sizeof(NameRef), NULL, NULL, 0, 0, 0};
+int ledger_capacity = 0;
+int ledger_complete = 1;
 AdminSettings admin_settings = {35067.0f, 55700.0f, 1.0f, "Tajwar", "tajwar123"};
 char current_user[MAX_NAME_LENGTH] = "";
 char user_type[10] = "";
@@ -55,18 +307,266 @@ static void sleep_sec(int seconds) {
 #endif
 }
 
+static PoolChunk* poolAddChunk(NodePool* pool, size_t capacity) {
+    PoolChunk* chunk = (PoolChunk*)malloc(POOL_HEADER_SIZE + capacity * pool->node_size);
+    if (chunk == NULL)
+        return NULL;
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+    pool->total_nodes += capacity;
+    pool->chunk_count++;
+    return chunk;
+}
+
+static void* poolAlloc(NodePool* pool) {
+    void* node = pool->free_list;
+    if (node != NULL) {
+        pool->free_list = *(void**)node;
+    } else {
+        PoolChunk* chunk = pool->chunks;
+        if (chunk == NULL || chunk->used == chunk->capacity) {
+            chunk = poolAddChunk(pool, POOL_CHUNK_NODES);
+            if (chunk == NULL)
+                return NULL;
+        }
+        node = (char*)chunk + POOL_HEADER_SIZE + chunk->used * pool->node_size;
+        chunk->used++;
+    }
+    pool->live_nodes++;
+    return node;
+}
+
+static void poolFree(NodePool* pool, void* node) {
+    *(void**)node = pool->free_list;
+    pool->free_list = node;
+    pool->live_nodes--;
+}
+
+static void poolRelease(NodePool* pool) {
+    PoolChunk* chunk = pool->chunks;
+    while (chunk != NULL) {
+        PoolChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    pool->chunks = NULL;
+    pool->free_list = NULL;
+    pool->live_nodes = pool->total_nodes = pool->chunk_count = 0;
+}
+
+static void poolAdopt(NodePool* pool, NodePool* donor) {
+    PoolChunk* last = donor->chunks;
+    if (last == NULL)
+        return;
+    for (PoolChunk* chunk = donor->chunks; chunk != NULL; chunk = chunk->next) {
+        while (chunk->used < chunk->capacity) {
+            void* node = (char*)chunk + POOL_HEADER_SIZE + chunk->used * donor->node_size;
+            *(void**)node = donor->free_list;
+            donor->free_list = node;
+            chunk->used++;
+        }
+        last = chunk;
+    }
+    if (pool->chunks == NULL) {
+        pool->chunks = donor->chunks;
+    } else {
+        last->next = pool->chunks->next;
+        pool->chunks->next = donor->chunks;
+    }
+    if (donor->free_list != NULL) {
+        void** tail = (void**)donor->free_list;
+        while (*tail != NULL)
+            tail = (void**)*tail;
+        *tail = pool->free_list;
+        pool->free_list = donor->free_list;
+    }
+    pool->live_nodes += donor->live_nodes;
+    pool->total_nodes += donor->total_nodes;
+    pool->chunk_count += donor->chunk_count;
+    donor->chunks = NULL;
+    donor->free_list = NULL;
+    donor->live_nodes = donor->total_nodes = donor->chunk_count = 0;
+}
+
+static size_t poolReservedBytes(const NodePool* pool) {
+    return pool->total_nodes * pool->node_size;
+}
+
+static size_t poolOverheadBytes(const NodePool* pool) {
+    return pool->chunk_count * (POOL_HEADER_SIZE + MALLOC_OVERHEAD);
+}
+
+static long long toPoisha(float amount) {
+    double scaled = (double)amount * 100.0;
+    return (long long)(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+}
+
+static double fromPoisha(long long poisha) {
+    return (double)poisha / 100.0;
+}
+
+static void columnsReserve(PaymentColumns* columns, size_t needed) {
+    if (needed <= columns->capacity)
+        return;
+    size_t new_capacity = (columns->capacity == 0) ? 1024 : columns->capacity;
+    while (new_capacity < needed)
+        new_capacity *= 2;
+    int* semester = (int*)realloc(columns->semester, new_capacity * sizeof(int));
+    if (semester != NULL)
+        columns->semester = semester;
+    long long* amount = (long long*)realloc(columns->amount, new_capacity * sizeof(long long));
+    if (amount != NULL)
+        columns->amount = amount;
+    PaymentNode** owner = (PaymentNode**)realloc(columns->owner, new_capacity * sizeof(PaymentNode*));
+    if (owner != NULL)
+        columns->owner = owner;
+    if (semester == NULL || amount == NULL || owner == NULL) {
+        perror("Failed to allocate payment columns");
+        exit(EXIT_FAILURE);
+    }
+    columns->capacity = new_capacity;
+}
+
+static void columnsPush(PaymentColumns* columns, PaymentNode* payment, long long amount) {
+    columnsReserve(columns, columns->count + 1);
+    payment->row = (int)columns->count;
+    columns->semester[columns->count] = payment->semester;
+    columns->amount[columns->count] = amount;
+    columns->owner[columns->count] = payment;
+    columns->count++;
+}
+
+static void columnsMerge(PaymentColumns* local) {
+    size_t base = payment_columns.count;
+    if (local->count == 0)
+        return;
+    columnsReserve(&payment_columns, base + local->count);
+    memcpy(payment_columns.semester + base, local->semester, local->count * sizeof(int));
+    memcpy(payment_columns.amount + base, local->amount, local->count * sizeof(long long));
+    memcpy(payment_columns.owner + base, local->owner, local->count * sizeof(PaymentNode*));
+    for (size_t i = 0; i < local->count; i++)
+        local->owner[i]->row = (int)(base + i);
+    payment_columns.count += local->count;
+    free(local->semester);
+    free(local->amount);
+    free(local->owner);
+    memset(local, 0, sizeof(PaymentColumns));
+}
+
+static void columnsRemove(PaymentNode* payment) {
+    PaymentColumns* columns = &payment_columns;
+    size_t row = (size_t)payment->row;
+    size_t last = --columns->count;
+    if (row != last) {
+        columns->semester[row] = columns->semester[last];
+        columns->amount[row] = columns->amount[last];
+        columns->owner[row] = columns->owner[last];
+        columns->owner[row]->row = (int)row;
+    }
+}
+
+static long long paymentAmount(const PaymentNode* payment) {
+    return payment_columns.amount[payment->row];
+}
+
+static long long studentPaidPoisha(const Student* student) {
+    long long total = toPoisha(student->admission_fee_paid);
+    for (PaymentNode* p = student->payments; p != NULL; p = p->next)
+        total += paymentAmount(p);
+    return total;
+}
+
+static long long studentDuePoisha(const Student* student) {
+    int max_semester = 0;
+    for (PaymentNode* p = student->payments; p != NULL; p = p->next) {
+        if (p->semester > max_semester)
+            max_semester = p->semester;
+    }
+    long long expected = max_semester * toPoisha(admin_settings.tuition_fee) + toPoisha(admin_settings.admission_fee);
+    return expected - studentPaidPoisha(student);
+}
+
 PaymentNode* createPaymentNode(int semester, float amount_paid) {
-    PaymentNode* new_payment = (PaymentNode*)malloc(sizeof(PaymentNode));
+    PaymentNode* new_payment = (PaymentNode*)poolAlloc(&payment_pool);
     if(new_payment == NULL) {
         perror("Failed to allocate memory for a new payment");
         exit(EXIT_FAILURE);
     }
     new_payment->semester = semester;
-    new_payment->amount_paid = amount_paid;
     new_payment->next = NULL;
+    columnsPush(&payment_columns, new_payment, toPoisha(amount_paid));
     return new_payment;
 }
 
+#ifdef _WIN32
+static DWORD WINAPI workerEntry(LPVOID param) {
+    WorkerStart* start = (WorkerStart*)param;
+    start->func(start->arg);
+    return 0;
+}
+#else
+static void* workerEntry(void* param) {
+    WorkerStart* start = (WorkerStart*)param;
+    start->func(start->arg);
+    return NULL;
+}
+#endif
+
+static int hardwareThreads() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int count = (int)info.dwNumberOfProcessors;
+#else
+    int count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (count < 1)
+        count = 1;
+    return (count > MAX_WORKER_THREADS) ? MAX_WORKER_THREADS : count;
+}
+
+static int workersFor(int records) {
+    int workers = records / MIN_RECORDS_PER_WORKER + 1;
+    int available = hardwareThreads();
+    return (workers > available) ? available : workers;
+}
+
+static void runParallel(WorkerFunc func, void* tasks, size_t task_size, int count) {
+    WorkerStart starts[MAX_WORKER_THREADS];
+    int started[MAX_WORKER_THREADS];
+#ifdef _WIN32
+    HANDLE threads[MAX_WORKER_THREADS];
+#else
+    pthread_t threads[MAX_WORKER_THREADS];
+#endif
+    for (int i = 1; i < count; i++) {
+        starts[i].func = func;
+        starts[i].arg = (char*)tasks + i * task_size;
+#ifdef _WIN32
+        threads[i] = CreateThread(NULL, 0, workerEntry, &starts[i], 0, NULL);
+        started[i] = (threads[i] != NULL);
+#else
+        started[i] = (pthread_create(&threads[i], NULL, workerEntry, &starts[i]) == 0);
+#endif
+        if (!started[i])
+            func(starts[i].arg);
+    }
+    if (count > 0)
+        func(tasks);
+    for (int i = 1; i < count; i++) {
+        if (!started[i])
+            continue;
+#ifdef _WIN32
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#else
+        pthread_join(threads[i], NULL);
+#endif
+    }
+}
+
 static void clearScreen() {
 #ifdef _WIN32
     system("cls");
@@ -75,97 +575,1435 @@ static void clearScreen() {
 #endif
 }
 
-static void getCurrentDateTime(char* dateTime) {
-    time_t now = time(NULL);
-    struct tm* t = localtime(&now);
+static long long currentTimestamp() {
+    return (long long)time(NULL);
+}
+
+static void formatDateTime(long long timestamp, char* dateTime) {
+    time_t value = (time_t)timestamp;
+    struct tm* t = localtime(&value);
+    if (timestamp <= 0 || t == NULL) {
+        strcpy(dateTime, "Unknown");
+        return;
+    }
     strftime(dateTime, MAX_DATE_LENGTH, "%Y-%m-%d %H:%M:%S", t);
 }
 
+static long long parseDateTime(const char* dateTime) {
+    struct tm t;
+    memset(&t, 0, sizeof(t));
+    if (sscanf(dateTime, "%d-%d-%d %d:%d:%d", &t.tm_year, &t.tm_mon, &t.tm_mday,
+               &t.tm_hour, &t.tm_min, &t.tm_sec) != 6)
+        return 0;
+    t.tm_year -= 1900;
+    t.tm_mon -= 1;
+    t.tm_isdst = -1;
+    time_t value = mktime(&t);
+    return (value == (time_t)-1) ? 0 : (long long)value;
+}
+
+static void iterPush(StudentIterator* it, Student* node) {
+    if (it->top == it->capacity) {
+        int new_capacity = it->capacity * 2;
+        Student** grown = (Student**)realloc(it->stack, new_capacity * sizeof(Student*));
+        if (grown == NULL) {
+            perror("Failed to grow traversal stack");
+            exit(EXIT_FAILURE);
+        }
+        it->stack = grown;
+        it->capacity = new_capacity;
+    }
+    it->stack[it->top++] = node;
+}
+
+static void iterInit(StudentIterator* it) {
+    it->top = 0;
+    it->capacity = ITERATOR_INITIAL_DEPTH;
+    it->stack = (Student**)malloc(it->capacity * sizeof(Student*));
+    if (it->stack == NULL) {
+        perror("Failed to allocate traversal stack");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void iterBegin(StudentIterator* it, Student* root) {
+    iterInit(it);
+    for (Student* node = root; node != NULL; node = node->left)
+        iterPush(it, node);
+}
+
+static void iterSeek(StudentIterator* it, Student* root, const char* student_id) {
+    iterInit(it);
+    Student* node = root;
+    while (node != NULL) {
+        if (strcmp(node->student_id, student_id) >= 0) {
+            iterPush(it, node);
+            node = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+}
+
+static Student* iterNext(StudentIterator* it) {
+    if (it->top == 0)
+        return NULL;
+    Student* node = it->stack[--it->top];
+    for (Student* child = node->right; child != NULL; child = child->left)
+        iterPush(it, child);
+    return node;
+}
+
+static void iterEnd(StudentIterator* it) {
+    free(it->stack);
+    it->stack = NULL;
+    it->top = it->capacity = 0;
+}
+
+static int traverseStudents(Student* root, const VisitorBinding* visitors, int visitor_count) {
+    StudentIterator it;
+    Student* student;
+    int visited = 0;
+    iterBegin(&it, root);
+    while ((student = iterNext(&it)) != NULL) {
+        for (int i = 0; i < visitor_count; i++)
+            visitors[i].visit(student, visitors[i].context);
+        visited++;
+    }
+    iterEnd(&it);
+    return visited;
+}
+
+static int pastRange(const IdRange* range, const char* student_id) {
+    if (range->prefix_length > 0)
+        return strncmp(student_id, range->low, range->prefix_length) > 0;
+    return strcmp(student_id, range->high) > 0;
+}
+
+static int traverseRange(Student* root, const IdRange* range, const VisitorBinding* visitors, int visitor_count) {
+    StudentIterator it;
+    Student* student;
+    int visited = 0;
+    iterSeek(&it, root, range->low);
+    while ((student = iterNext(&it)) != NULL && !pastRange(range, student->student_id)) {
+        for (int i = 0; i < visitor_count; i++)
+            visitors[i].visit(student, visitors[i].context);
+        visited++;
+    }
+    iterEnd(&it);
+    return visited;
+}
+
+static int visitStudents(Student* root, StudentVisitor visit, void* context) {
+    VisitorBinding binding = {visit, context};
+    return traverseStudents(root, &binding, 1);
+}
+
+static void countVisitor(Student* student, void* context) {
+    (void)student;
+    (*(int*)context)++;
+}
+
+static long long sumPoisha(const long long* amount, size_t count) {
+    size_t i = 0;
+    long long total = 0;
+#if defined(__AVX2__)
+    __m256i low = _mm256_setzero_si256(), high = _mm256_setzero_si256();
+    for (; i + 8 <= count; i += 8) {
+        low = _mm256_add_epi64(low, _mm256_loadu_si256((const __m256i*)(amount + i)));
+        high = _mm256_add_epi64(high, _mm256_loadu_si256((const __m256i*)(amount + i + 4)));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, _mm256_add_epi64(low, high));
+    total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(__SSE2__) || defined(_M_X64)
+    __m128i low = _mm_setzero_si128(), high = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4) {
+        low = _mm_add_epi64(low, _mm_loadu_si128((const __m128i*)(amount + i)));
+        high = _mm_add_epi64(high, _mm_loadu_si128((const __m128i*)(amount + i + 2)));
+    }
+    long long lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, _mm_add_epi64(low, high));
+    total = lanes[0] + lanes[1];
+#endif
+    for (; i < count; i++)
+        total += amount[i];
+    return total;
+}
+
+static size_t countBelowPoisha(const long long* amount, size_t count, long long limit) {
+    size_t i = 0;
+    long long below = 0;
+#if defined(__AVX2__)
+    __m256i bound = _mm256_set1_epi64x(limit), acc = _mm256_setzero_si256();
+    for (; i + 4 <= count; i += 4) {
+        __m256i diff = _mm256_sub_epi64(_mm256_loadu_si256((const __m256i*)(amount + i)), bound);
+        acc = _mm256_add_epi64(acc, _mm256_srli_epi64(diff, 63));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    below = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(__SSE2__) || defined(_M_X64)
+    __m128i bound = _mm_set1_epi64x(limit), acc = _mm_setzero_si128();
+    for (; i + 2 <= count; i += 2) {
+        __m128i diff = _mm_sub_epi64(_mm_loadu_si128((const __m128i*)(amount + i)), bound);
+        acc = _mm_add_epi64(acc, _mm_srli_epi64(diff, 63));
+    }
+    long long lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    below = lanes[0] + lanes[1];
+#endif
+    for (; i < count; i++)
+        below += (amount[i] < limit);
+    return (size_t)below;
+}
+
+static SemesterLedger* ledgerEntry(SemesterLedger** ledger, int* capacity, int semester) {
+    if (semester >= *capacity) {
+        int new_capacity = (*capacity == 0) ? 16 : *capacity;
+        while (new_capacity <= semester)
+            new_capacity *= 2;
+        SemesterLedger* grown = (SemesterLedger*)realloc(*ledger, new_capacity * sizeof(SemesterLedger));
+        if (grown == NULL) {
+            perror("Failed to allocate semester ledger");
+            exit(EXIT_FAILURE);
+        }
+        memset(grown + *capacity, 0, (new_capacity - *capacity) * sizeof(SemesterLedger));
+        *ledger = grown;
+        *capacity = new_capacity;
+    }
+    return &(*ledger)[semester];
+}
+
+static void ledgerAccumulate(SemesterLedger** ledger, int* capacity, int semester, long long amount, int sign) {
+    SemesterLedger* entry = ledgerEntry(ledger, capacity, semester);
+    entry->payment_count += sign;
+    entry->amount_total += sign * amount;
+    if (amount >= toPoisha(admin_settings.tuition_fee))
+        entry->full_count += sign;
+    else
+        entry->partial_count += sign;
+}
+
+static void ledgerRecord(int semester, long long amount, int sign) {
+    ledgerAccumulate(&semester_ledger, &ledger_capacity, semester, amount, sign);
+}
+
+static void ledgerMerge(const SemesterLedger* ledger, int capacity, int sign) {
+    for (int semester = capacity - 1; semester >= 0; semester--) {
+        if (ledger[semester].payment_count == 0)
+            continue;
+        SemesterLedger* entry = ledgerEntry(&semester_ledger, &ledger_capacity, semester);
+        entry->payment_count += sign * ledger[semester].payment_count;
+        entry->amount_total += sign * ledger[semester].amount_total;
+        entry->full_count += sign * ledger[semester].full_count;
+        entry->partial_count += sign * ledger[semester].partial_count;
+    }
+}
+
+static void ledgerRebuild() {
+    const int* semester = payment_columns.semester;
+    const long long* amount = payment_columns.amount;
+    long long tuition = toPoisha(admin_settings.tuition_fee);
+    if (semester_ledger != NULL)
+        memset(semester_ledger, 0, ledger_capacity * sizeof(SemesterLedger));
+    for (size_t i = 0; i < payment_columns.count; i++) {
+        SemesterLedger* entry = ledgerEntry(&semester_ledger, &ledger_capacity, semester[i]);
+        entry->payment_count++;
+        entry->amount_total += amount[i];
+        if (amount[i] >= tuition)
+            entry->full_count++;
+        else
+            entry->partial_count++;
+    }
+}
+
 static int bstCountNodes(Student* node) {
-    if (node == NULL)
+    int count = 0;
+    visitStudents(node, countVisitor, &count);
+    return count;
+}
+
+static void collectInorder(Student* node, Student** nodes, int* count) {
+    StudentIterator it;
+    Student* student;
+    iterBegin(&it, node);
+    while ((student = iterNext(&it)) != NULL)
+        nodes[(*count)++] = student;
+    iterEnd(&it);
+}
+
+static Student* buildBalanced(Student** nodes, int begin, int end) {
+    if (begin >= end)
+        return NULL;
+    int mid = begin + (end - begin) / 2;
+    Student* root = nodes[mid];
+    root->left = buildBalanced(nodes, begin, mid);
+    root->right = buildBalanced(nodes, mid + 1, end);
+    return root;
+}
+
+static unsigned long long hashStudentId(const char* student_id) {
+    unsigned long long hash = 1469598103934665603ULL;
+    for (const unsigned char* c = (const unsigned char*)student_id; *c; c++) {
+        hash ^= *c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static void bloomReset(int expected_keys) {
+    if (expected_keys < BLOOM_MIN_KEYS)
+        expected_keys = BLOOM_MIN_KEYS;
+    size_t bit_count = (size_t)expected_keys * BLOOM_BITS_PER_KEY;
+    unsigned char* bits = (unsigned char*)calloc((bit_count + 7) / 8, 1);
+    if (bits == NULL) {
+        perror("Failed to allocate Bloom filter");
+        exit(EXIT_FAILURE);
+    }
+    free(student_bloom.bits);
+    student_bloom.bits = bits;
+    student_bloom.bit_count = bit_count;
+    student_bloom.sized_for = expected_keys;
+    student_bloom.keys = 0;
+    student_bloom.removed = 0;
+}
+
+static void filterSet(unsigned char* bits, size_t bit_count, const char* student_id) {
+    unsigned long long hash = hashStudentId(student_id);
+    unsigned long long h1 = hash & 0xffffffffULL, h2 = (hash >> 32) | 1;
+    for (int i = 0; i < BLOOM_HASHES; i++) {
+        size_t bit = (size_t)((h1 + i * h2) % bit_count);
+        bits[bit / 8] |= (unsigned char)(1 << (bit % 8));
+    }
+}
+
+static int filterTest(const unsigned char* bits, size_t bit_count, const char* student_id) {
+    unsigned long long hash = hashStudentId(student_id);
+    unsigned long long h1 = hash & 0xffffffffULL, h2 = (hash >> 32) | 1;
+    for (int i = 0; i < BLOOM_HASHES; i++) {
+        size_t bit = (size_t)((h1 + i * h2) % bit_count);
+        if (!(bits[bit / 8] & (1 << (bit % 8))))
+            return 0;
+    }
+    return 1;
+}
+
+static void bloomAdd(const char* student_id) {
+    if (student_bloom.bits == NULL)
+        bloomReset(BLOOM_MIN_KEYS);
+    filterSet(student_bloom.bits, student_bloom.bit_count, student_id);
+    student_bloom.keys++;
+}
+
+static int bloomMayContain(const char* student_id) {
+    if (student_bloom.bits == NULL)
         return 0;
-    return 1 + bstCountNodes(node->left) + bstCountNodes(node->right);
+    return filterTest(student_bloom.bits, student_bloom.bit_count, student_id);
 }
 
-static void inorderAccumTotals(Student* node, float* totalAdmission, float* totalTuition, int* totalEntries) {
-    if (node == NULL)
+static void bloomVisitor(Student* student, void* context) {
+    (void)context;
+    bloomAdd(student->student_id);
+}
+
+static void bloomMaintain() {
+    int live = student_bloom.keys - student_bloom.removed;
+    if (student_bloom.keys <= student_bloom.sized_for && student_bloom.removed * 4 <= student_bloom.keys)
         return;
-    inorderAccumTotals(node->left, totalAdmission, totalTuition, totalEntries);
-    *totalAdmission += node->admission_fee_paid;
-    PaymentNode* p = node->payments;
-    while (p != NULL) {
-        *totalTuition += p->amount_paid;
-        (*totalEntries)++;
-        p = p->next;
+    bloomReset(live * 2);
+    visitStudents(studentRoot, bloomVisitor, NULL);
+}
+
+static double bloomEstimatedFalsePositiveRate() {
+    size_t set_bits = 0;
+    if (student_bloom.bit_count == 0)
+        return 0.0;
+    for (size_t i = 0; i < (student_bloom.bit_count + 7) / 8; i++) {
+        for (unsigned char byte = student_bloom.bits[i]; byte; byte &= byte - 1)
+            set_bits++;
     }
-    inorderAccumTotals(node->right, totalAdmission, totalTuition, totalEntries);
+    double fill = (double)set_bits / student_bloom.bit_count;
+    double rate = 1.0;
+    for (int i = 0; i < BLOOM_HASHES; i++)
+        rate *= fill;
+    return rate;
 }
 
-static void bstWriteStudentData(Student* node, FILE* file) {
-    if (node == NULL)
+static void hashTableInit(HashTable* table, size_t capacity) {
+    table->slots = (HashSlot*)calloc(capacity, sizeof(HashSlot));
+    if (table->slots == NULL) {
+        perror("Failed to allocate student index");
+        exit(EXIT_FAILURE);
+    }
+    table->capacity = capacity;
+    table->live = 0;
+}
+
+static size_t hashTableFind(const HashTable* table, unsigned long long hash, const char* student_id) {
+    if (table->slots == NULL)
+        return (size_t)-1;
+    size_t mask = table->capacity - 1;
+    for (size_t i = hash & mask; table->slots[i].student != NULL; i = (i + 1) & mask) {
+        Student* student = table->slots[i].student;
+        if (table->slots[i].hash == hash && student != HASH_TOMBSTONE &&
+            strcmp(student->student_id, student_id) == 0)
+            return i;
+    }
+    return (size_t)-1;
+}
+
+static void hashTablePut(HashTable* table, unsigned long long hash, Student* student) {
+    size_t mask = table->capacity - 1;
+    size_t i = hash & mask;
+    while (table->slots[i].student != NULL)
+        i = (i + 1) & mask;
+    table->slots[i].hash = hash;
+    table->slots[i].student = student;
+    table->live++;
+}
+
+static void hashTableRemoveAt(HashTable* table, size_t hole) {
+    size_t mask = table->capacity - 1;
+    size_t i = (hole + 1) & mask;
+    while (table->slots[i].student != NULL) {
+        size_t home = table->slots[i].hash & mask;
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            table->slots[hole] = table->slots[i];
+            hole = i;
+        }
+        i = (i + 1) & mask;
+    }
+    table->slots[hole].student = NULL;
+    table->slots[hole].hash = 0;
+    table->live--;
+}
+
+static void indexMigrate(size_t steps) {
+    HashTable* draining = &student_index.draining;
+    if (draining->slots == NULL)
         return;
-    bstWriteStudentData(node->left, file);
-    fwrite(node->student_id, sizeof(char), 20, file);
-    fwrite(node->name, sizeof(char), MAX_NAME_LENGTH, file);
-    fwrite(node->department, sizeof(char), MAX_DEPT_LENGTH, file);
-    fwrite(&node->admission_fee_paid, sizeof(float), 1, file);
-    fwrite(node->created_date, sizeof(char), MAX_DATE_LENGTH, file);
-    fwrite(node->last_updated, sizeof(char), MAX_DATE_LENGTH, file);
-    int payment_count = 0;
-    PaymentNode* p = node->payments;
-    while (p != NULL) {
-        payment_count++;
-        p = p->next;
+    while (steps-- > 0 && student_index.migrate_position < draining->capacity) {
+        HashSlot* slot = &draining->slots[student_index.migrate_position++];
+        if (slot->student != NULL && slot->student != HASH_TOMBSTONE)
+            hashTablePut(&student_index.current, slot->hash, slot->student);
     }
-    fwrite(&payment_count, sizeof(int), 1, file);
-    p = node->payments;
-    while (p != NULL) {
-        fwrite(&p->semester, sizeof(int), 1, file);
-        fwrite(&p->amount_paid, sizeof(float), 1, file);
-        p = p->next;
+    if (student_index.migrate_position == draining->capacity) {
+        free(draining->slots);
+        draining->slots = NULL;
+        draining->capacity = draining->live = 0;
     }
-    bstWriteStudentData(node->right, file);
 }
 
-static void inorderSearchByNameHelper(Student* node, const char* search_lower) {
+static void indexReset(int expected_keys) {
+    size_t capacity = HASH_MIN_CAPACITY;
+    while (capacity * HASH_MAX_LOAD_PERCENT / 100 < (size_t)expected_keys)
+        capacity *= 2;
+    free(student_index.current.slots);
+    free(student_index.draining.slots);
+    memset(&student_index.draining, 0, sizeof(HashTable));
+    student_index.migrate_position = 0;
+    hashTableInit(&student_index.current, capacity);
+}
+
+static Student* indexLookup(const char* student_id) {
+    unsigned long long hash = hashStudentId(student_id);
+    size_t slot = hashTableFind(&student_index.current, hash, student_id);
+    if (slot != (size_t)-1)
+        return student_index.current.slots[slot].student;
+    slot = hashTableFind(&student_index.draining, hash, student_id);
+    if (slot != (size_t)-1)
+        return student_index.draining.slots[slot].student;
+    return NULL;
+}
+
+static void indexInsert(Student* student) {
+    if (student_index.current.slots == NULL)
+        indexReset(0);
+    indexMigrate(HASH_MIGRATE_STEP);
+    HashTable* current = &student_index.current;
+    if ((current->live + 1) * 100 > current->capacity * HASH_MAX_LOAD_PERCENT) {
+        indexMigrate(student_index.draining.capacity);
+        student_index.draining = *current;
+        student_index.migrate_position = 0;
+        student_index.resizes++;
+        hashTableInit(current, student_index.draining.capacity * 2);
+    }
+    unsigned long long hash = hashStudentId(student->student_id);
+    size_t slot = hashTableFind(current, hash, student->student_id);
+    if (slot != (size_t)-1)
+        current->slots[slot].student = student;
+    else
+        hashTablePut(current, hash, student);
+}
+
+static void indexRemove(const char* student_id) {
+    unsigned long long hash = hashStudentId(student_id);
+    indexMigrate(HASH_MIGRATE_STEP);
+    size_t slot = hashTableFind(&student_index.current, hash, student_id);
+    if (slot != (size_t)-1)
+        hashTableRemoveAt(&student_index.current, slot);
+    slot = hashTableFind(&student_index.draining, hash, student_id);
+    if (slot != (size_t)-1) {
+        student_index.draining.slots[slot].student = HASH_TOMBSTONE;
+        student_index.draining.live--;
+    }
+}
+
+static void indexVisitor(Student* student, void* context) {
+    (void)context;
+    indexInsert(student);
+}
+
+static void normalizeName(const char* name, char* normalized) {
+    int length = 0, pending_space = 0;
+    for (const char* c = name; *c && length < MAX_NAME_LENGTH - 1; c++) {
+        if (isspace((unsigned char)*c)) {
+            pending_space = (length > 0);
+            continue;
+        }
+        if (pending_space && length < MAX_NAME_LENGTH - 2)
+            normalized[length++] = ' ';
+        pending_space = 0;
+        normalized[length++] = (char)tolower((unsigned char)*c);
+    }
+    normalized[length] = 0;
+}
+
+static int editDistance(const char* a, const char* b) {
+    int previous[MAX_NAME_LENGTH + 1], current[MAX_NAME_LENGTH + 1];
+    int la = (int)strlen(a), lb = (int)strlen(b);
+    for (int j = 0; j <= lb; j++)
+        previous[j] = j;
+    for (int i = 1; i <= la; i++) {
+        current[0] = i;
+        for (int j = 1; j <= lb; j++) {
+            int best = previous[j - 1] + (a[i - 1] != b[j - 1]);
+            if (previous[j] + 1 < best)
+                best = previous[j] + 1;
+            if (current[j - 1] + 1 < best)
+                best = current[j - 1] + 1;
+            current[j] = best;
+        }
+        memcpy(previous, current, (lb + 1) * sizeof(int));
+    }
+    return previous[lb];
+}
+
+static BKNode* bkNewNode(const char* key, int distance) {
+    BKNode* node = (BKNode*)poolAlloc(&bk_node_pool);
+    if (node == NULL) {
+        perror("Failed to allocate name index node");
+        exit(EXIT_FAILURE);
+    }
+    strcpy(node->key, key);
+    node->distance = distance;
+    node->first_child = node->next_sibling = NULL;
+    node->refs = NULL;
+    return node;
+}
+
+static BKNode* bkLocate(const char* key, int create) {
+    if (name_index_root == NULL) {
+        if (create)
+            name_index_root = bkNewNode(key, 0);
+        return name_index_root;
+    }
+    BKNode* node = name_index_root;
+    while (1) {
+        int d = editDistance(key, node->key);
+        if (d == 0)
+            return node;
+        BKNode* child = node->first_child;
+        while (child != NULL && child->distance != d)
+            child = child->next_sibling;
+        if (child == NULL) {
+            if (!create)
+                return NULL;
+            child = bkNewNode(key, d);
+            child->next_sibling = node->first_child;
+            node->first_child = child;
+            return child;
+        }
+        node = child;
+    }
+}
+
+static void bkAdd(const char* key, Student* student) {
+    size_t keys = bk_node_pool.live_nodes;
+    BKNode* node = bkLocate(key, 1);
+    if (node->refs == NULL && bk_node_pool.live_nodes == keys)
+        name_index_dead_keys--;
+    NameRef* ref = (NameRef*)poolAlloc(&name_ref_pool);
+    if (ref == NULL) {
+        perror("Failed to allocate name index entry");
+        exit(EXIT_FAILURE);
+    }
+    ref->student = student;
+    ref->next = node->refs;
+    node->refs = ref;
+}
+
+static void bkRemove(const char* key, Student* student) {
+    BKNode* node = bkLocate(key, 0);
     if (node == NULL)
         return;
-    inorderSearchByNameHelper(node->left, search_lower);
+    for (NameRef** link = &node->refs; *link != NULL; link = &(*link)->next) {
+        if ((*link)->student == student) {
+            NameRef* ref = *link;
+            *link = ref->next;
+            poolFree(&name_ref_pool, ref);
+            if (node->refs == NULL)
+                name_index_dead_keys++;
+            return;
+        }
+    }
+}
+
+static void nameIndexApply(Student* student, void (*apply)(const char*, Student*)) {
+    char normalized[MAX_NAME_LENGTH];
+    char token[MAX_NAME_LENGTH];
+    normalizeName(student->name, normalized);
+    if (normalized[0] == 0)
+        return;
+    apply(normalized, student);
+    if (strchr(normalized, ' ') == NULL)
+        return;
+    for (const char* start = normalized; *start; ) {
+        size_t length = strcspn(start, " ");
+        if (length >= 2) {
+            memcpy(token, start, length);
+            token[length] = 0;
+            apply(token, student);
+        }
+        start += length;
+        if (*start == ' ')
+            start++;
+    }
+}
+
+static void nameIndexAdd(Student* student) {
+    if (name_index_built)
+        nameIndexApply(student, bkAdd);
+}
+
+static void nameIndexRemove(Student* student) {
+    if (name_index_built)
+        nameIndexApply(student, bkRemove);
+}
+
+static void nameIndexVisitor(Student* student, void* context) {
+    (void)context;
+    nameIndexAdd(student);
+}
+
+static void nameIndexRebuild() {
+    poolRelease(&bk_node_pool);
+    poolRelease(&name_ref_pool);
+    name_index_root = NULL;
+    name_index_dead_keys = 0;
+    name_index_built = 1;
+    visitStudents(studentRoot, nameIndexVisitor, NULL);
+}
+
+static size_t nameIndexLiveKeys() {
+    return bk_node_pool.live_nodes - (size_t)name_index_dead_keys;
+}
+
+static void nameIndexMaintain() {
+    if (!name_index_built || (size_t)name_index_dead_keys * 4 > bk_node_pool.live_nodes)
+        nameIndexRebuild();
+}
+
+static void fuzzyAddMatch(FuzzyMatch* matches, int* count, int limit, Student* student, int distance) {
+    int position = -1;
+    for (int i = 0; i < *count; i++) {
+        if (matches[i].student == student) {
+            if (matches[i].distance <= distance)
+                return;
+            position = i;
+            break;
+        }
+    }
+    if (position < 0) {
+        if (*count == limit && matches[limit - 1].distance <= distance)
+            return;
+        position = (*count < limit) ? (*count)++ : limit - 1;
+    }
+    while (position > 0 && (matches[position - 1].distance > distance ||
+           (matches[position - 1].distance == distance &&
+            strcmp(matches[position - 1].student->student_id, student->student_id) > 0))) {
+        matches[position] = matches[position - 1];
+        position--;
+    }
+    matches[position].student = student;
+    matches[position].distance = distance;
+}
+
+static int fuzzySearch(const char* query, FuzzyMatch* matches, int limit, int* examined) {
+    char normalized[MAX_NAME_LENGTH];
+    int count = 0, tolerance = FUZZY_MAX_DISTANCE;
+    int stack_size = 0, stack_capacity = 64;
+    BKNode** stack = (BKNode**)malloc(stack_capacity * sizeof(BKNode*));
+    if (stack == NULL) {
+        perror("Failed to allocate search stack");
+        exit(EXIT_FAILURE);
+    }
+    nameIndexMaintain();
+    normalizeName(query, normalized);
+    *examined = 0;
+    if (name_index_root != NULL)
+        stack[stack_size++] = name_index_root;
+    while (stack_size > 0) {
+        BKNode* node = stack[--stack_size];
+        int d = editDistance(normalized, node->key);
+        if (node->refs != NULL)
+            (*examined)++;
+        if (d <= tolerance) {
+            for (NameRef* ref = node->refs; ref != NULL; ref = ref->next)
+                fuzzyAddMatch(matches, &count, limit, ref->student, d);
+            if (count == limit && matches[limit - 1].distance < tolerance)
+                tolerance = matches[limit - 1].distance;
+        }
+        for (BKNode* child = node->first_child; child != NULL; child = child->next_sibling) {
+            if (child->distance < d - tolerance || child->distance > d + tolerance)
+                continue;
+            if (stack_size == stack_capacity) {
+                stack_capacity *= 2;
+                BKNode** grown = (BKNode**)realloc(stack, stack_capacity * sizeof(BKNode*));
+                if (grown == NULL) {
+                    perror("Failed to grow search stack");
+                    exit(EXIT_FAILURE);
+                }
+                stack = grown;
+            }
+            stack[stack_size++] = child;
+        }
+    }
+    free(stack);
+    return count;
+}
+
+static void shardPrefixOf(const char* student_id, char* prefix) {
+    const char* dash = strchr(student_id, '-');
+    size_t length = strlen(student_id);
+    size_t limit = SHARD_PLAIN_PREFIX_LENGTH;
+    if (dash != NULL)
+        limit = ((size_t)(dash - student_id) < SHARD_PREFIX_LENGTH) ? (size_t)(dash - student_id) + 1 : SHARD_PREFIX_LENGTH;
+    if (length > limit)
+        length = limit;
+    memcpy(prefix, student_id, length);
+    prefix[length] = 0;
+}
+
+static int inShard(Student* node, const char* prefix) {
+    char node_prefix[SHARD_PREFIX_LENGTH + 1];
+    shardPrefixOf(node->student_id, node_prefix);
+    return strcmp(node_prefix, prefix) == 0;
+}
+
+
+static void writeStudentRecord(Student* student, FILE* file) {
+    fwrite(student->student_id, sizeof(char), 20, file);
+    fwrite(student->name, sizeof(char), MAX_NAME_LENGTH, file);
+    fwrite(student->department, sizeof(char), MAX_DEPT_LENGTH, file);
+    fwrite(&student->admission_fee_paid, sizeof(float), 1, file);
+    fwrite(&student->created_time, sizeof(long long), 1, file);
+    fwrite(&student->updated_time, sizeof(long long), 1, file);
+    fwrite(&student->payment_count, sizeof(int), 1, file);
+    for (PaymentNode* p = student->payments; p != NULL; p = p->next) {
+        float amount = (float)fromPoisha(paymentAmount(p));
+        fwrite(&p->semester, sizeof(int), 1, file);
+        fwrite(&amount, sizeof(float), 1, file);
+    }
+}
+
+static void chunkIndexAppend(ChunkIndex* index, long long offset) {
+    if (index->count == index->capacity) {
+        int new_capacity = (index->capacity == 0) ? 16 : index->capacity * 2;
+        long long* grown = (long long*)realloc(index->offsets, new_capacity * sizeof(long long));
+        if (grown == NULL) {
+            perror("Failed to allocate chunk index");
+            exit(EXIT_FAILURE);
+        }
+        index->offsets = grown;
+        index->capacity = new_capacity;
+    }
+    index->offsets[index->count++] = offset;
+}
+
+static void shardFilterReset(Shard* shard) {
+    int keys = (shard->student_count > SHARD_FILTER_MIN_KEYS) ? shard->student_count : SHARD_FILTER_MIN_KEYS;
+    size_t bit_count = ((size_t)keys * BLOOM_BITS_PER_KEY + 7) / 8 * 8;
+    unsigned char* bits = (unsigned char*)calloc(bit_count / 8, 1);
+    if (bits == NULL) {
+        perror("Failed to allocate shard filter");
+        exit(EXIT_FAILURE);
+    }
+    free(shard->filter);
+    shard->filter = bits;
+    shard->filter_bits = bit_count;
+}
+
+static void shardLedgerReset(Shard* shard) {
+    if (shard->ledger != NULL)
+        memset(shard->ledger, 0, shard->ledger_capacity * sizeof(SemesterLedger));
+}
+
+static void shardLedgerAdd(Shard* shard, Student* student) {
+    for (PaymentNode* p = student->payments; p != NULL; p = p->next)
+        ledgerAccumulate(&shard->ledger, &shard->ledger_capacity, p->semester, paymentAmount(p), 1);
+}
+
+static int writeShardRecords(Shard* shard, FILE* file, ChunkIndex* index) {
+    StudentIterator it;
+    Student* student;
+    const char* prefix = shard->prefix;
+    size_t len = strlen(prefix);
+    int count = 0;
+    shardFilterReset(shard);
+    shardLedgerReset(shard);
+    iterSeek(&it, studentRoot, prefix);
+    while ((student = iterNext(&it)) != NULL && strncmp(student->student_id, prefix, len) == 0) {
+        if (inShard(student, prefix)) {
+            if (count % LOAD_CHUNK_RECORDS == 0)
+                chunkIndexAppend(index, (long long)ftell(file));
+            writeStudentRecord(student, file);
+            filterSet(shard->filter, shard->filter_bits, student->student_id);
+            shardLedgerAdd(shard, student);
+            count++;
+        }
+    }
+    iterEnd(&it);
+    return count;
+}
+
+static void studentListAppend(StudentList* list, Student* student) {
+    if (list->count == list->capacity) {
+        int new_capacity = (list->capacity == 0) ? 64 : list->capacity * 2;
+        Student** grown = (Student**)realloc(list->items, new_capacity * sizeof(Student*));
+        if (grown == NULL) {
+            perror("Failed to allocate student list");
+            exit(EXIT_FAILURE);
+        }
+        list->items = grown;
+        list->capacity = new_capacity;
+    }
+    list->items[list->count++] = student;
+}
+
+static void listVisitor(Student* student, void* context) {
+    studentListAppend((StudentList*)context, student);
+}
+
+static void inorderSearchByNameHelper(Student* node, const char* search_lower, StudentList* results) {
+    StudentIterator it;
+    Student* student;
     char name_lower[MAX_NAME_LENGTH];
-    strcpy(name_lower, node->name);
-    for (int i = 0; name_lower[i]; i++) {
-        name_lower[i] = tolower(name_lower[i]);
+    iterBegin(&it, node);
+    while ((student = iterNext(&it)) != NULL) {
+        strcpy(name_lower, student->name);
+        for (int i = 0; name_lower[i]; i++) {
+            name_lower[i] = tolower(name_lower[i]);
+        }
+        if (strstr(name_lower, search_lower) != NULL) {
+            studentListAppend(results, student);
+        }
+    }
+    iterEnd(&it);
+}
+
+static void bstCollectAfter(Student* root, const char* after_id, const IdRange* range,
+                            Student** page, int* count, int limit) {
+    StudentIterator it;
+    Student* student;
+    const char* start = (after_id[0] == 0 && range != NULL) ? range->low : after_id;
+    iterSeek(&it, root, start);
+    while (*count < limit && (student = iterNext(&it)) != NULL) {
+        if (range != NULL && pastRange(range, student->student_id))
+            break;
+        if (strcmp(student->student_id, after_id) > 0)
+            page[(*count)++] = student;
     }
-    if (strstr(name_lower, search_lower) != NULL) {
-        printf("ID: %s, Name: %s, Dept: %s\n", node->student_id, node->name, node->department);
+    iterEnd(&it);
+}
+
+static void outputOpen(OutputBuffer* out, FILE* file) {
+    out->file = file;
+    out->used = 0;
+    out->data = (char*)malloc(OUTPUT_BUFFER_SIZE);
+    if (out->data == NULL) {
+        perror("Failed to allocate output buffer");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void outputFlush(OutputBuffer* out) {
+    if (out->used > 0)
+        fwrite(out->data, 1, out->used, out->file);
+    out->used = 0;
+}
+
+static void outputClose(OutputBuffer* out) {
+    outputFlush(out);
+    fflush(out->file);
+    free(out->data);
+    out->data = NULL;
+}
+
+static void outputPrintf(OutputBuffer* out, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(out->data + out->used, OUTPUT_BUFFER_SIZE - out->used, format, args);
+    va_end(args);
+    if (written < 0)
+        return;
+    if ((size_t)written < OUTPUT_BUFFER_SIZE - out->used) {
+        out->used += written;
+        return;
+    }
+    outputFlush(out);
+    va_start(args, format);
+    if ((size_t)written < OUTPUT_BUFFER_SIZE)
+        out->used = vsnprintf(out->data, OUTPUT_BUFFER_SIZE, format, args);
+    else
+        vfprintf(out->file, format, args);
+    va_end(args);
+}
+
+void displayHeader();
+int loginScreen();
+void adminMenu();
+void displayStudentMenu(Student* student);
+void addStudent();
+void viewAllStudents();
+void searchStudent();
+void searchByIdRange();
+void updateStudentInfo();
+void deleteStudent();
+void makeSemesterPayment(Student* student);
+void modifyFeeSettings();
+void modifyDisplayMultiplier();
+void displayMemoryDiagnostics();
+int compactMemory();
+void simulateFeeChange();
+Student* bstInsert(Student* root, Student* new_student);
+Student* findStudent(const char* student_id);
+Student* bstDelete(Student* root, const char* student_id);
+float calculateTotalPaid(Student* student);
+float calculateDue(Student* student);
+void displayStudentInfo(Student* student);
+void displayTotalAmountPaid();
+void displaySemesterCollection();
+void saveData();
+void loadData();
+
+static void shardFileName(int index, char* file_name) {
+    sprintf(file_name, "students_%03d.dat", index);
+}
+
+static int* shardSlotFor(const char* prefix) {
+    size_t mask = (size_t)shard_slot_capacity - 1;
+    size_t i = hashStudentId(prefix) & mask;
+    while (shard_slots[i] != 0 && strcmp(shards[shard_slots[i] - 1].prefix, prefix) != 0)
+        i = (i + 1) & mask;
+    return &shard_slots[i];
+}
+
+static void shardSlotsRebuild(int capacity) {
+    int* slots = (int*)calloc(capacity, sizeof(int));
+    if (slots == NULL) {
+        perror("Failed to allocate shard table");
+        exit(EXIT_FAILURE);
+    }
+    free(shard_slots);
+    shard_slots = slots;
+    shard_slot_capacity = capacity;
+    for (int i = 0; i < shard_count; i++)
+        *shardSlotFor(shards[i].prefix) = i + 1;
+}
+
+static Shard* findShard(const char* prefix) {
+    if (shard_slots == NULL)
+        return NULL;
+    int slot = *shardSlotFor(prefix);
+    return (slot != 0) ? &shards[slot - 1] : NULL;
+}
+
+static Shard* addShard(const char* prefix) {
+    if (shard_count == shard_capacity) {
+        int new_capacity = (shard_capacity == 0) ? 8 : shard_capacity * 2;
+        Shard* grown = (Shard*)realloc(shards, new_capacity * sizeof(Shard));
+        if (grown == NULL) {
+            perror("Failed to allocate shard table");
+            exit(EXIT_FAILURE);
+        }
+        shards = grown;
+        shard_capacity = new_capacity;
+    }
+    Shard* shard = &shards[shard_count++];
+    memset(shard, 0, sizeof(Shard));
+    strcpy(shard->prefix, prefix);
+    if (shard_count * 2 > shard_slot_capacity)
+        shardSlotsRebuild((shard_slot_capacity == 0) ? 16 : shard_slot_capacity * 2);
+    else
+        *shardSlotFor(prefix) = shard_count;
+    return shard;
+}
+
+static Shard* shardForStudent(const char* student_id, int create) {
+    char prefix[SHARD_PREFIX_LENGTH + 1];
+    shardPrefixOf(student_id, prefix);
+    Shard* shard = findShard(prefix);
+    if (shard == NULL && create) {
+        shard = addShard(prefix);
+        shard->loaded = 1;
+        shard->dirty = 1;
+    }
+    return shard;
+}
+
+static int takeBytes(ParseTask* task, void* dest, size_t size) {
+    if (size > task->size - task->offset) {
+        memset(dest, 0, size);
+        task->offset = task->size;
+        return 0;
+    }
+    memcpy(dest, task->data + task->offset, size);
+    task->offset += size;
+    return 1;
+}
+
+static Student* parseStudentRecord(ParseTask* task) {
+    Student* new_student = (Student*)poolAlloc(task->students);
+    if (!new_student) {
+        perror("Memory allocation error");
+        exit(EXIT_FAILURE);
+    }
+    int complete = takeBytes(task, new_student->student_id, 20);
+    complete &= takeBytes(task, new_student->name, MAX_NAME_LENGTH);
+    complete &= takeBytes(task, new_student->department, MAX_DEPT_LENGTH);
+    complete &= takeBytes(task, &new_student->admission_fee_paid, sizeof(float));
+    if (task->version == 1) {
+        char legacy_date[MAX_DATE_LENGTH];
+        complete &= takeBytes(task, legacy_date, MAX_DATE_LENGTH);
+        legacy_date[MAX_DATE_LENGTH - 1] = 0;
+        new_student->created_time = parseDateTime(legacy_date);
+        complete &= takeBytes(task, legacy_date, MAX_DATE_LENGTH);
+        legacy_date[MAX_DATE_LENGTH - 1] = 0;
+        new_student->updated_time = parseDateTime(legacy_date);
+    } else {
+        complete &= takeBytes(task, &new_student->created_time, sizeof(long long));
+        complete &= takeBytes(task, &new_student->updated_time, sizeof(long long));
+    }
+    complete &= takeBytes(task, &new_student->payment_count, sizeof(int));
+    if (!complete) {
+        poolFree(task->students, new_student);
+        return NULL;
+    }
+    new_student->payments = NULL;
+    new_student->left = new_student->right = NULL;
+    PaymentNode** tail = &new_student->payments;
+    for (int j = 0; j < new_student->payment_count; j++) {
+        PaymentNode* new_payment = (PaymentNode*)poolAlloc(task->payments);
+        if (new_payment == NULL) {
+            perror("Failed to allocate memory for a new payment");
+            exit(EXIT_FAILURE);
+        }
+        float amount_paid;
+        if (!takeBytes(task, &new_payment->semester, sizeof(int)) ||
+            !takeBytes(task, &amount_paid, sizeof(float))) {
+            poolFree(task->payments, new_payment);
+            new_student->payment_count = j;
+            break;
+        }
+        new_payment->next = NULL;
+        columnsPush(task->columns, new_payment, toPoisha(amount_paid));
+        ledgerAccumulate(&task->ledger, &task->ledger_capacity, new_payment->semester, toPoisha(amount_paid), 1);
+        *tail = new_payment;
+        tail = &new_payment->next;
+    }
+    return new_student;
+}
+
+static void parseWorker(void* arg) {
+    ParseTask* task = (ParseTask*)arg;
+    while (task->parsed < task->expected) {
+        Student* student = parseStudentRecord(task);
+        if (student == NULL)
+            break;
+        task->run[task->parsed++] = student;
+    }
+}
+
+static int compareStudentIds(const void* a, const void* b) {
+    return strcmp((*(Student* const*)a)->student_id, (*(Student* const*)b)->student_id);
+}
+
+static void discardStudent(Student* student) {
+    PaymentNode* p = student->payments;
+    while (p != NULL) {
+        PaymentNode* next = p->next;
+        ledgerRecord(p->semester, paymentAmount(p), -1);
+        columnsRemove(p);
+        poolFree(&payment_pool, p);
+        p = next;
+    }
+    poolFree(&student_pool, student);
+}
+
+static int stitchStudents(Student** run, int count) {
+    for (int i = 1; i < count; i++) {
+        if (strcmp(run[i - 1]->student_id, run[i]->student_id) >= 0) {
+            qsort(run, count, sizeof(Student*), compareStudentIds);
+            break;
+        }
+    }
+    Student** nodes = (Student**)malloc((student_pool.live_nodes + 1) * sizeof(Student*));
+    if (nodes == NULL) {
+        perror("Failed to allocate load buffer");
+        exit(EXIT_FAILURE);
+    }
+    Student** tree_nodes = nodes + count;
+    int total = 0, kept = 0, i = 0, j = 0, existing = 0;
+    collectInorder(studentRoot, tree_nodes, &existing);
+    while (i < existing || j < count) {
+        int order = (i == existing) ? 1 : (j == count) ? -1 : strcmp(tree_nodes[i]->student_id, run[j]->student_id);
+        if (order < 0) {
+            nodes[total++] = tree_nodes[i++];
+        } else if (order == 0 || (total > 0 && strcmp(nodes[total - 1]->student_id, run[j]->student_id) == 0)) {
+            discardStudent(run[j++]);
+        } else {
+            nodes[total++] = run[kept++] = run[j++];
+        }
+    }
+    studentRoot = buildBalanced(nodes, 0, total);
+    free(nodes);
+    return kept;
+}
+
+static int parseStudentFile(const char* file_name, StudentList* batch) {
+    FILE* file = fopen(file_name, "rb");
+    if (file == NULL)
+        return 0;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* data = (size > 0) ? (char*)malloc(size) : NULL;
+    if (data == NULL || fread(data, 1, size, file) != (size_t)size) {
+        free(data);
+        fclose(file);
+        return 0;
+    }
+    fclose(file);
+
+    ParseTask reader;
+    memset(&reader, 0, sizeof(reader));
+    reader.data = data;
+    reader.size = (size_t)size;
+    reader.version = 1;
+    int count = 0, chunk_records = 0, chunk_count = 0;
+    long long index_offset = 0;
+    takeBytes(&reader, &count, sizeof(int));
+    if (count == DATA_MAGIC) {
+        takeBytes(&reader, &reader.version, sizeof(int));
+        takeBytes(&reader, &count, sizeof(int));
+        if (reader.version >= 3) {
+            takeBytes(&reader, &chunk_records, sizeof(int));
+            takeBytes(&reader, &index_offset, sizeof(long long));
+        }
+    }
+    size_t min_record = 20 + MAX_NAME_LENGTH + MAX_DEPT_LENGTH + sizeof(float) + 2 * sizeof(long long) + sizeof(int);
+    if (count < 0)
+        count = 0;
+    if ((size_t)count > reader.size / min_record)
+        count = (int)(reader.size / min_record);
+
+    ParseTask index = reader;
+    if (chunk_records > 0 && index_offset > 0 && (size_t)index_offset < reader.size) {
+        index.offset = (size_t)index_offset;
+        takeBytes(&index, &chunk_count, sizeof(int));
+        if (chunk_count != (count + chunk_records - 1) / chunk_records ||
+            (size_t)chunk_count * sizeof(long long) > index.size - index.offset)
+            chunk_count = 0;
+    }
+    int workers = 1;
+    if (chunk_count > 0) {
+        workers = workersFor(count);
+        if (workers > chunk_count)
+            workers = chunk_count;
+    }
+
+    if (batch->count + count > batch->capacity) {
+        int new_capacity = batch->count + count;
+        Student** grown = (Student**)realloc(batch->items, (new_capacity + 1) * sizeof(Student*));
+        if (grown == NULL) {
+            perror("Failed to allocate load buffer");
+            exit(EXIT_FAILURE);
+        }
+        batch->items = grown;
+        batch->capacity = new_capacity;
+    }
+    Student** run = batch->items + batch->count;
+    ParseTask tasks[MAX_WORKER_THREADS];
+    for (int w = 0; w < workers; w++) {
+        ParseTask* task = &tasks[w];
+        int first_chunk = (int)((long long)chunk_count * w / workers);
+        int next_chunk = (int)((long long)chunk_count * (w + 1) / workers);
+        int first_record = first_chunk * chunk_records;
+        *task = reader;
+        task->local_students.node_size = sizeof(Student);
+        task->local_payments.node_size = sizeof(PaymentNode);
+        task->students = (workers == 1) ? &student_pool : &task->local_students;
+        task->payments = (workers == 1) ? &payment_pool : &task->local_payments;
+        task->columns = (workers == 1) ? &payment_columns : &task->local_columns;
+        task->run = run + first_record;
+        task->expected = count;
+        if (chunk_count > 0) {
+            long long chunk_offset = 0;
+            index.offset = (size_t)index_offset + sizeof(int) + (size_t)first_chunk * sizeof(long long);
+            takeBytes(&index, &chunk_offset, sizeof(long long));
+            task->offset = (chunk_offset > 0 && (size_t)chunk_offset < reader.size) ? (size_t)chunk_offset : reader.size;
+            task->expected = ((next_chunk * chunk_records < count) ? next_chunk * chunk_records : count) - first_record;
+        }
+    }
+    runParallel(parseWorker, tasks, sizeof(ParseTask), workers);
+
+    int loaded = 0;
+    for (int w = 0; w < workers; w++) {
+        poolAdopt(&student_pool, &tasks[w].local_students);
+        poolAdopt(&payment_pool, &tasks[w].local_payments);
+        columnsMerge(&tasks[w].local_columns);
+        ledgerMerge(tasks[w].ledger, tasks[w].ledger_capacity, 1);
+        free(tasks[w].ledger);
+        memmove(run + loaded, tasks[w].run, tasks[w].parsed * sizeof(Student*));
+        loaded += tasks[w].parsed;
+    }
+    batch->count += loaded;
+    free(data);
+    return loaded;
+}
+
+static int stitchBatch(StudentList* batch, int count_shards) {
+    int loaded = stitchStudents(batch->items, batch->count);
+    for (int i = 0; i < loaded; i++) {
+        Student* student = batch->items[i];
+        bloomAdd(student->student_id);
+        indexInsert(student);
+        nameIndexAdd(student);
+        if (count_shards)
+            shardForStudent(student->student_id, 1)->student_count++;
+    }
+    free(batch->items);
+    batch->items = NULL;
+    batch->count = batch->capacity = 0;
+    bloomMaintain();
+    return loaded;
+}
+
+static int loadStudentFile(const char* file_name, int count_shards) {
+    StudentList batch = {NULL, 0, 0};
+    parseStudentFile(file_name, &batch);
+    return stitchBatch(&batch, count_shards);
+}
+
+static void parseShard(Shard* shard, StudentList* batch) {
+    char file_name[32];
+    shard->loaded = 1;
+    ledgerMerge(shard->ledger, shard->ledger_capacity, -1);
+    shardFileName((int)(shard - shards), file_name);
+    parseStudentFile(file_name, batch);
+}
+
+static void loadShard(Shard* shard) {
+    StudentList batch = {NULL, 0, 0};
+    parseShard(shard, &batch);
+    stitchBatch(&batch, 0);
+}
+
+static void loadAllShards() {
+    StudentList batch = {NULL, 0, 0};
+    int pending = 0;
+    for (int i = 0; i < shard_count; i++) {
+        if (!shards[i].loaded) {
+            parseShard(&shards[i], &batch);
+            pending++;
+        }
+    }
+    if (pending > 0)
+        stitchBatch(&batch, 0);
+}
+
+static void loadShardsInRange(const IdRange* range) {
+    StudentList batch = {NULL, 0, 0};
+    int pending = 0;
+    for (int i = 0; i < shard_count; i++) {
+        const char* prefix = shards[i].prefix;
+        size_t len = strlen(prefix);
+        if (shards[i].loaded)
+            continue;
+        if (range->prefix_length > 0) {
+            size_t common = (len < (size_t)range->prefix_length) ? len : (size_t)range->prefix_length;
+            if (strncmp(prefix, range->low, common) != 0)
+                continue;
+        } else if (strncmp(prefix, range->low, len) < 0 || strcmp(prefix, range->high) > 0) {
+            continue;
+        }
+        parseShard(&shards[i], &batch);
+        pending++;
+    }
+    if (pending > 0)
+        stitchBatch(&batch, 0);
+}
+
+static void migrateShardPrefixes() {
+    char prefix[SHARD_PREFIX_LENGTH + 1];
+    int stale = 0;
+    for (int i = 0; i < shard_count && !stale; i++) {
+        shardPrefixOf(shards[i].prefix, prefix);
+        stale = strcmp(prefix, shards[i].prefix) != 0;
+    }
+    if (!stale)
+        return;
+    loadAllShards();
+    for (int i = 0; i < shard_count; i++) {
+        shards[i].student_count = 0;
+        shards[i].dirty = 1;
+    }
+    StudentIterator it;
+    Student* student;
+    iterBegin(&it, studentRoot);
+    while ((student = iterNext(&it)) != NULL)
+        shardForStudent(student->student_id, 1)->student_count++;
+    iterEnd(&it);
+    int kept = 0;
+    for (int i = 0; i < shard_count; i++) {
+        if (shards[i].student_count == 0) {
+            free(shards[i].filter);
+            free(shards[i].ledger);
+            continue;
+        }
+        shards[kept++] = shards[i];
+    }
+    shard_count = kept;
+    shardSlotsRebuild(shard_slot_capacity);
+}
+
+static void markShardDirty(const char* student_id) {
+    Shard* shard = shardForStudent(student_id, 1);
+    shard->dirty = 1;
+}
+
+static void shardFilterBuild(Shard* shard) {
+    StudentIterator it;
+    Student* student;
+    size_t len = strlen(shard->prefix);
+    shardFilterReset(shard);
+    iterSeek(&it, studentRoot, shard->prefix);
+    while ((student = iterNext(&it)) != NULL && strncmp(student->student_id, shard->prefix, len) == 0) {
+        if (inShard(student, shard->prefix))
+            filterSet(shard->filter, shard->filter_bits, student->student_id);
+    }
+    iterEnd(&it);
+}
+
+static void shardLedgerBuild(Shard* shard) {
+    StudentIterator it;
+    Student* student;
+    size_t len = strlen(shard->prefix);
+    shardLedgerReset(shard);
+    iterSeek(&it, studentRoot, shard->prefix);
+    while ((student = iterNext(&it)) != NULL && strncmp(student->student_id, shard->prefix, len) == 0) {
+        if (inShard(student, shard->prefix))
+            shardLedgerAdd(shard, student);
+    }
+    iterEnd(&it);
+}
+
+static void rebuildLedgers() {
+    loadAllShards();
+    ledgerRebuild();
+    for (int i = 0; i < shard_count; i++)
+        shardLedgerBuild(&shards[i]);
+    ledger_complete = 1;
+}
+
+static void writeManifest() {
+    FILE* file = fopen(MANIFEST_FILE, "wb");
+    if (file == NULL)
+        return;
+    int magic = DATA_MAGIC, version = DATA_VERSION;
+    fwrite(&magic, sizeof(int), 1, file);
+    fwrite(&version, sizeof(int), 1, file);
+    fwrite(&shard_count, sizeof(int), 1, file);
+    for (int i = 0; i < shard_count; i++) {
+        fwrite(shards[i].prefix, sizeof(char), SHARD_PREFIX_LENGTH + 1, file);
+        fwrite(&shards[i].student_count, sizeof(int), 1, file);
+        int filter_bytes = (int)((shards[i].filter_bits + 7) / 8);
+        fwrite(&filter_bytes, sizeof(int), 1, file);
+        fwrite(shards[i].filter, sizeof(unsigned char), filter_bytes, file);
+        fwrite(&shards[i].ledger_capacity, sizeof(int), 1, file);
+        fwrite(shards[i].ledger, sizeof(SemesterLedger), shards[i].ledger_capacity, file);
+    }
+    fclose(file);
+}
+
+static int readManifest() {
+    FILE* file = fopen(MANIFEST_FILE, "rb");
+    if (file == NULL)
+        return 0;
+    int magic = 0, version = 0, count = 0;
+    fread(&magic, sizeof(int), 1, file);
+    fread(&version, sizeof(int), 1, file);
+    fread(&count, sizeof(int), 1, file);
+    if (magic != DATA_MAGIC) {
+        fclose(file);
+        return 0;
+    }
+    for (int i = 0; i < count; i++) {
+        char prefix[SHARD_PREFIX_LENGTH + 1];
+        int student_count = 0;
+        if (fread(prefix, sizeof(char), SHARD_PREFIX_LENGTH + 1, file) != SHARD_PREFIX_LENGTH + 1)
+            break;
+        fread(&student_count, sizeof(int), 1, file);
+        prefix[SHARD_PREFIX_LENGTH] = 0;
+        Shard* shard = addShard(prefix);
+        shard->student_count = student_count;
+        int filter_bytes = 0;
+        if (version >= 4 && fread(&filter_bytes, sizeof(int), 1, file) == 1 && filter_bytes > 0) {
+            shard->filter = (unsigned char*)malloc(filter_bytes);
+            if (shard->filter == NULL) {
+                perror("Failed to allocate shard filter");
+                exit(EXIT_FAILURE);
+            }
+            if (fread(shard->filter, sizeof(unsigned char), filter_bytes, file) == (size_t)filter_bytes) {
+                shard->filter_bits = (size_t)filter_bytes * 8;
+            } else {
+                free(shard->filter);
+                shard->filter = NULL;
+            }
+        }
+        int semesters = 0;
+        if (version < 5 || fread(&semesters, sizeof(int), 1, file) != 1) {
+            ledger_complete = 0;
+        } else if (semesters > 0) {
+            shard->ledger = (SemesterLedger*)calloc(semesters, sizeof(SemesterLedger));
+            if (shard->ledger == NULL) {
+                perror("Failed to allocate semester ledger");
+                exit(EXIT_FAILURE);
+            }
+            shard->ledger_capacity = semesters;
+            if (fread(shard->ledger, sizeof(SemesterLedger), semesters, file) != (size_t)semesters) {
+                memset(shard->ledger, 0, semesters * sizeof(SemesterLedger));
+                ledger_complete = 0;
+            }
+            ledgerMerge(shard->ledger, shard->ledger_capacity, 1);
+        }
     }
-    inorderSearchByNameHelper(node->right, search_lower);
+    fclose(file);
+    return 1;
 }
 
-void displayHeader();
-int loginScreen();
-void adminMenu();
-void displayStudentMenu(Student* student);
-void addStudent();
-void viewAllStudents();
-void searchStudent();
-void updateStudentInfo();
-void deleteStudent();
-void makeSemesterPayment(Student* student);
-void modifyFeeSettings();
-void modifyDisplayMultiplier();
-Student* bstInsert(Student* root, Student* new_student);
-Student* bstSearch(Student* root, const char* student_id);
-Student* bstDelete(Student* root, const char* student_id);
-Student* minValueStudent(Student* node);
-void inorderDisplay(Student* root);
-float calculateTotalPaid(Student* student);
-float calculateDue(Student* student);
-void displayStudentInfo(Student* student);
-void displayTotalAmountPaid();
-void saveData();
-void loadData();
-
 void displayHeader() {
     clearScreen();
     printf("\n==================================================\n");
@@ -178,71 +2016,72 @@ void displayHeader() {
 }
 
 Student* bstInsert(Student* root, Student* new_student) {
-    if (root == NULL)
-        return new_student;
-    if (strcmp(new_student->student_id, root->student_id) < 0)
-        root->left = bstInsert(root->left, new_student);
-    else if (strcmp(new_student->student_id, root->student_id) > 0)
-        root->right = bstInsert(root->right, new_student);
+    Student** link = &root;
+    while (*link != NULL) {
+        int cmp = strcmp(new_student->student_id, (*link)->student_id);
+        if (cmp == 0)
+            return root;
+        link = (cmp < 0) ? &(*link)->left : &(*link)->right;
+    }
+    *link = new_student;
     return root;
 }
 
-Student* bstSearch(Student* root, const char* student_id) {
-    if (root == NULL || strcmp(root->student_id, student_id) == 0)
-        return root;
-    if (strcmp(student_id, root->student_id) < 0)
-        return bstSearch(root->left, student_id);
-    return bstSearch(root->right, student_id);
-}
-
-Student* minValueStudent(Student* node) {
-    Student* current = node;
-    while (current && current->left != NULL)
-        current = current->left;
-    return current;
+Student* findStudent(const char* student_id) {
+    Shard* shard = shardForStudent(student_id, 0);
+    if (shard == NULL)
+        return NULL;
+    student_bloom.queries++;
+    if (!shard->loaded) {
+        if (shard->filter != NULL && !filterTest(shard->filter, shard->filter_bits, student_id)) {
+            student_bloom.rejects++;
+            return NULL;
+        }
+        loadShard(shard);
+    }
+    if (!bloomMayContain(student_id)) {
+        student_bloom.rejects++;
+        return NULL;
+    }
+    Student* student = indexLookup(student_id);
+    if (student == NULL)
+        student_bloom.false_positives++;
+    return student;
 }
 
 Student* bstDelete(Student* root, const char* student_id) {
-    if (root == NULL)
+    Student** link = &root;
+    while (*link != NULL) {
+        int cmp = strcmp(student_id, (*link)->student_id);
+        if (cmp == 0)
+            break;
+        link = (cmp < 0) ? &(*link)->left : &(*link)->right;
+    }
+    Student* target = *link;
+    if (target == NULL)
         return root;
-    if (strcmp(student_id, root->student_id) < 0)
-        root->left = bstDelete(root->left, student_id);
-    else if (strcmp(student_id, root->student_id) > 0)
-        root->right = bstDelete(root->right, student_id);
-    else {
-        if (root->left == NULL) {
-            Student* temp = root->right;
-            free(root);
-            return temp;
-        } else if (root->right == NULL) {
-            Student* temp = root->left;
-            free(root);
-            return temp;
-        }
-        Student* temp = minValueStudent(root->right);
-        strcpy(root->student_id, temp->student_id);
-        strcpy(root->name, temp->name);
-        strcpy(root->department, temp->department);
-        root->admission_fee_paid = temp->admission_fee_paid;
-        strcpy(root->created_date, temp->created_date);
-        strcpy(root->last_updated, temp->last_updated);
-        root->payments = temp->payments;
-        root->right = bstDelete(root->right, temp->student_id);
+    if (target->left == NULL) {
+        *link = target->right;
+    } else if (target->right == NULL) {
+        *link = target->left;
+    } else {
+        Student* parent = target;
+        Student* successor = target->right;
+        while (successor->left != NULL) {
+            parent = successor;
+            successor = successor->left;
+        }
+        if (parent != target) {
+            parent->left = successor->right;
+            successor->right = target->right;
+        }
+        successor->left = target->left;
+        *link = successor;
     }
+    poolFree(&student_pool, target);
     return root;
 }
 
-void inorderDisplay(Student* root) {
-    if (root != NULL) {
-        inorderDisplay(root->left);
-        float total_paid = calculateTotalPaid(root) * admin_settings.display_multiplier;
-        float due = calculateDue(root) * admin_settings.display_multiplier;
-        printf("%-10s %-20s %-15s %-14.2f taka %-14.2f taka\n", 
-            root->student_id, root->name, root->department, total_paid, due);
-        inorderDisplay(root->right);
-    }
-}
-
 int loginScreen() {
     int choice;
     char student_id[20];
@@ -285,7 +2124,7 @@ int loginScreen() {
                 printf("\nEnter student ID: ");
                 fgets(student_id, 20, stdin);
                 student_id[strcspn(student_id, "\n")] = 0;
-                student = bstSearch(studentRoot, student_id);
+                student = findStudent(student_id);
                 if (student != NULL) {
                     strcpy(current_user, student->name);
                     strcpy(user_type, "Student");
@@ -325,8 +2164,10 @@ void adminMenu() {
         printf("6. Modify Fee Settings\n");
         printf("7. Modify Display Multiplier\n");
         printf("8. Show Total Amount Paid by All Students\n");
-        printf("9. Logout\n");
-        printf("\nEnter your choice (1-9): ");
+        printf("9. Semester Collection Report\n");
+        printf("10. Memory Diagnostics\n");
+        printf("11. Logout\n");
+        printf("\nEnter your choice (1-11): ");
         if (scanf("%d", &choice) != 1) {
             while(getchar() != '\n');
             continue;
@@ -358,6 +2199,12 @@ void adminMenu() {
                 displayTotalAmountPaid();
                 break;
             case 9:
+                displaySemesterCollection();
+                break;
+            case 10:
+                displayMemoryDiagnostics();
+                break;
+            case 11:
                 printf("\nLogging out...\n");
                 sleep_sec(1);
                 saveData();
@@ -405,12 +2252,13 @@ void displayStudentMenu(Student* student) {
 }
 
 void addStudent() {
-    Student* new_student = (Student*)malloc(sizeof(Student));
+    Student* new_student = (Student*)poolAlloc(&student_pool);
     if (!new_student) {
         perror("Memory allocation error");
         exit(EXIT_FAILURE);
     }
     new_student->payments = NULL;
+    new_student->payment_count = 0;
     new_student->left = new_student->right = NULL;
     char admission_choice, payment_choice;
     displayHeader();
@@ -419,10 +2267,10 @@ void addStudent() {
     printf("Enter Student ID: ");
     fgets(new_student->student_id, 20, stdin);
     new_student->student_id[strcspn(new_student->student_id, "\n")] = 0;
-    if (bstSearch(studentRoot, new_student->student_id) != NULL) {
+    if (findStudent(new_student->student_id) != NULL) {
         printf("\nError: A student with this ID already exists.\n");
         sleep_sec(1);
-        free(new_student);
+        poolFree(&student_pool, new_student);
         return;
     }
     printf("Enter Student Name: ");
@@ -436,9 +2284,18 @@ void addStudent() {
     scanf(" %c", &admission_choice);
     getchar();
     new_student->admission_fee_paid = (tolower(admission_choice) == 'y') ? admin_settings.admission_fee : 0;
-    getCurrentDateTime(new_student->created_date);
-    strcpy(new_student->last_updated, new_student->created_date);
+    new_student->created_time = currentTimestamp();
+    new_student->updated_time = new_student->created_time;
     studentRoot = bstInsert(studentRoot, new_student);
+    indexInsert(new_student);
+    nameIndexAdd(new_student);
+    bloomAdd(new_student->student_id);
+    bloomMaintain();
+    Shard* shard = shardForStudent(new_student->student_id, 1);
+    shard->student_count++;
+    shard->dirty = 1;
+    if (shard->filter != NULL)
+        filterSet(shard->filter, shard->filter_bits, new_student->student_id);
     printf("\nStudent added successfully!\n");
     sleep_sec(1);
     printf("\nDo you want to add a semester payment now? (y/n): ");
@@ -453,7 +2310,175 @@ void addStudent() {
     saveData();
 }
 
+static void admissionVisitor(Student* student, void* context) {
+    *(long long*)context += toPoisha(student->admission_fee_paid);
+}
+
+static void totalsVisitor(Student* student, void* context) {
+    PaymentTotals* totals = (PaymentTotals*)context;
+    totals->admission += toPoisha(student->admission_fee_paid);
+    for (PaymentNode* p = student->payments; p != NULL; p = p->next) {
+        totals->tuition += paymentAmount(p);
+        totals->entries++;
+    }
+    totals->due += studentDuePoisha(student);
+}
+
+static int totalStudentCount() {
+    int count = 0;
+    for (int i = 0; i < shard_count; i++)
+        count += shards[i].student_count;
+    return count;
+}
+
+static void writeListingHeader(OutputBuffer* out) {
+    outputPrintf(out, "%-10s %-20s %-15s %-15s %-15s\n", "ID", "Name", "Department", "Total Paid", "Due Amount");
+    outputPrintf(out, "-----------------------------------------------------------------------\n");
+}
+
+static void writeStudentRow(OutputBuffer* out, Student* student) {
+    float total_paid = calculateTotalPaid(student) * admin_settings.display_multiplier;
+    float due = calculateDue(student) * admin_settings.display_multiplier;
+    outputPrintf(out, "%-10s %-20s %-15s %-14.2f taka %-14.2f taka\n",
+        student->student_id, student->name, student->department, total_paid, due);
+}
+
+static void rowVisitor(Student* student, void* context) {
+    writeStudentRow((OutputBuffer*)context, student);
+}
+
+static int compareByName(const void* a, const void* b) {
+    const Student* left = *(Student* const*)a;
+    const Student* right = *(Student* const*)b;
+    int cmp = strcmp(left->name, right->name);
+    return (cmp != 0) ? cmp : strcmp(left->student_id, right->student_id);
+}
+
+static int compareByDue(const void* a, const void* b) {
+    const DueEntry* left = (const DueEntry*)a;
+    const DueEntry* right = (const DueEntry*)b;
+    if (left->due != right->due)
+        return (left->due < right->due) ? 1 : -1;
+    return strcmp(left->student->student_id, right->student->student_id);
+}
+
+static void sortStudents(StudentList* list, int order) {
+    if (order == SORT_BY_NAME) {
+        qsort(list->items, list->count, sizeof(Student*), compareByName);
+    } else if (order == SORT_BY_DUE && list->count > 0) {
+        DueEntry* entries = (DueEntry*)malloc(list->count * sizeof(DueEntry));
+        if (entries == NULL) {
+            perror("Failed to allocate sort buffer");
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < list->count; i++) {
+            entries[i].student = list->items[i];
+            entries[i].due = studentDuePoisha(list->items[i]);
+        }
+        qsort(entries, list->count, sizeof(DueEntry), compareByDue);
+        for (int i = 0; i < list->count; i++)
+            list->items[i] = entries[i].student;
+        free(entries);
+    }
+}
+
+static void exportListing(const StudentList* list, const IdRange* range) {
+    char file_name[100];
+    printf("\nEnter export file name: ");
+    fgets(file_name, sizeof(file_name), stdin);
+    file_name[strcspn(file_name, "\n")] = 0;
+    FILE* file = fopen(file_name, "w");
+    if (file == NULL) {
+        printf("\nError: Could not open %s for writing.\n", file_name);
+        sleep_sec(1);
+        return;
+    }
+    OutputBuffer out;
+    int exported = 0;
+    outputOpen(&out, file);
+    writeListingHeader(&out);
+    if (list == NULL && range != NULL) {
+        VisitorBinding binding = {rowVisitor, &out};
+        exported = traverseRange(studentRoot, range, &binding, 1);
+    } else if (list == NULL) {
+        exported = visitStudents(studentRoot, rowVisitor, &out);
+    } else {
+        for (int i = 0; i < list->count; i++)
+            writeStudentRow(&out, list->items[i]);
+        exported = list->count;
+    }
+    outputClose(&out);
+    fclose(file);
+    printf("\nExported %d students to %s.\n", exported, file_name);
+    sleep_sec(1);
+}
+
+static void pageStudents(const char* title, const StudentList* list, const IdRange* range, int total) {
+    int page_capacity = 16;
+    int page_number = 0;
+    char choice;
+    Student* page[PAGE_SIZE];
+    OutputBuffer out;
+    char (*page_starts)[20] = malloc(page_capacity * sizeof(*page_starts));
+    if (page_starts == NULL) {
+        perror("Failed to allocate pager history");
+        exit(EXIT_FAILURE);
+    }
+    page_starts[0][0] = 0;
+    while (1) {
+        int count = 0;
+        int first = page_number * PAGE_SIZE;
+        if (list == NULL) {
+            bstCollectAfter(studentRoot, page_starts[page_number], range, page, &count, PAGE_SIZE);
+        } else {
+            while (count < PAGE_SIZE && first + count < list->count) {
+                page[count] = list->items[first + count];
+                count++;
+            }
+        }
+        displayHeader();
+        outputOpen(&out, stdout);
+        outputPrintf(&out, "\n%s - Page %d\n", title, page_number + 1);
+        outputPrintf(&out, "--------------------------------------------------\n");
+        writeListingHeader(&out);
+        for (int i = 0; i < count; i++)
+            writeStudentRow(&out, page[i]);
+        if (count == 0)
+            outputPrintf(&out, "No more students.\n");
+        else
+            outputPrintf(&out, "\nShowing %d-%d of %d\n", first + 1, first + count, total);
+        outputPrintf(&out, "\n[N]ext  [P]revious  [E]xport to file  [Q]uit: ");
+        outputClose(&out);
+        if (scanf(" %c", &choice) != 1)
+            break;
+        getchar();
+        choice = tolower(choice);
+        if (choice == 'n' && count == PAGE_SIZE && first + count < total) {
+            if (page_number + 1 >= page_capacity) {
+                page_capacity *= 2;
+                page_starts = realloc(page_starts, page_capacity * sizeof(*page_starts));
+                if (page_starts == NULL) {
+                    perror("Failed to allocate pager history");
+                    exit(EXIT_FAILURE);
+                }
+            }
+            strcpy(page_starts[page_number + 1], page[count - 1]->student_id);
+            page_number++;
+        } else if (choice == 'p' && page_number > 0) {
+            page_number--;
+        } else if (choice == 'e') {
+            exportListing(list, range);
+        } else if (choice == 'q') {
+            break;
+        }
+    }
+    free(page_starts);
+}
+
 void viewAllStudents() {
+    int order;
+    StudentList list = {NULL, 0, 0};
+    loadAllShards();
     displayHeader();
     printf("\nALL STUDENTS\n");
     printf("--------------------------------------------------\n");
@@ -463,13 +2488,25 @@ void viewAllStudents() {
         getchar();
         return;
     }
-    printf("%-10s %-20s %-15s %-15s %-15s\n", "ID", "Name", "Department", "Total Paid", "Due Amount");
-    printf("-----------------------------------------------------------------------\n");
-    inorderDisplay(studentRoot);
-    int count = bstCountNodes(studentRoot);
-    printf("\nTotal Students: %d\n", count);
-    printf("\nPress Enter to continue...");
-    getchar();
+    printf("Sort by:\n");
+    printf("1. Student ID\n");
+    printf("2. Name\n");
+    printf("3. Due Amount (highest first)\n");
+    printf("\nEnter your choice (1-3): ");
+    if (scanf("%d", &order) != 1 || order < SORT_BY_ID || order > SORT_BY_DUE) {
+        while(getchar() != '\n');
+        order = SORT_BY_ID;
+    } else {
+        getchar();
+    }
+    if (order == SORT_BY_ID) {
+        pageStudents("ALL STUDENTS (by ID)", NULL, NULL, totalStudentCount());
+        return;
+    }
+    visitStudents(studentRoot, listVisitor, &list);
+    sortStudents(&list, order);
+    pageStudents(order == SORT_BY_NAME ? "ALL STUDENTS (by Name)" : "ALL STUDENTS (by Due)", &list, NULL, list.count);
+    free(list.items);
 }
 
 void searchStudent() {
@@ -481,8 +2518,10 @@ void searchStudent() {
     printf("--------------------------------------------------\n");
     printf("1. Search by ID\n");
     printf("2. Search by Name\n");
-    printf("3. Return to Admin Menu\n");
-    printf("\nEnter your choice (1-3): ");
+    printf("3. Fuzzy Search by Name (typo-tolerant)\n");
+    printf("4. Search by ID Prefix or Range\n");
+    printf("5. Return to Admin Menu\n");
+    printf("\nEnter your choice (1-5): ");
     if (scanf("%d", &choice) != 1) {
         while(getchar()!='\n');
         return;
@@ -493,7 +2532,7 @@ void searchStudent() {
             printf("\nEnter Student ID to search: ");
             fgets(search_term, MAX_NAME_LENGTH, stdin);
             search_term[strcspn(search_term, "\n")] = 0;
-            student = bstSearch(studentRoot, search_term);
+            student = findStudent(search_term);
             if (student != NULL) {
                 displayStudentInfo(student);
             } else {
@@ -508,13 +2547,45 @@ void searchStudent() {
             for (int i = 0; search_term[i]; i++) {
                 search_term[i] = tolower(search_term[i]);
             }
-            printf("\nSearch Results:\n");
+            loadAllShards();
+            StudentList results = {NULL, 0, 0};
+            inorderSearchByNameHelper(studentRoot, search_term, &results);
+            if (results.count == 0) {
+                printf("\nNo students matched that name.\n");
+                printf("\nPress Enter to continue...");
+                getchar();
+            } else {
+                pageStudents("SEARCH RESULTS", &results, NULL, results.count);
+            }
+            free(results.items);
+            break;
+        case 3:
+            printf("\nEnter Student Name to search: ");
+            fgets(search_term, MAX_NAME_LENGTH, stdin);
+            search_term[strcspn(search_term, "\n")] = 0;
+            loadAllShards();
+            FuzzyMatch matches[FUZZY_RESULT_LIMIT];
+            int examined = 0;
+            int found = fuzzySearch(search_term, matches, FUZZY_RESULT_LIMIT, &examined);
+            printf("\nClosest Matches:\n");
             printf("--------------------------------------------------\n");
-            inorderSearchByNameHelper(studentRoot, search_term);
+            if (found == 0) {
+                printf("No students within %d edits of that name.\n", FUZZY_MAX_DISTANCE);
+            } else {
+                printf("%-6s %-10s %-20s %-15s\n", "Edits", "ID", "Name", "Department");
+                for (int i = 0; i < found; i++) {
+                    printf("%-6d %-10s %-20s %-15s\n", matches[i].distance, matches[i].student->student_id,
+                           matches[i].student->name, matches[i].student->department);
+                }
+            }
+            printf("\nCompared against %d of %zu indexed names.\n", examined, nameIndexLiveKeys());
             printf("\nPress Enter to continue...");
             getchar();
             break;
-        case 3:
+        case 4:
+            searchByIdRange();
+            break;
+        case 5:
             return;
         default:
             printf("\nInvalid choice.\n");
@@ -523,6 +2594,73 @@ void searchStudent() {
     }
 }
 
+void searchByIdRange() {
+    int mode;
+    char view_choice;
+    char title[80];
+    IdRange range;
+    PaymentTotals totals = {0, 0, 0, 0};
+    VisitorBinding visitors[1] = {{totalsVisitor, &totals}};
+    memset(&range, 0, sizeof(range));
+    printf("\n1. IDs starting with a prefix (e.g. 242-15-)\n");
+    printf("2. IDs between two values (inclusive)\n");
+    printf("\nEnter your choice (1-2): ");
+    if (scanf("%d", &mode) != 1 || (mode != 1 && mode != 2)) {
+        while(getchar() != '\n');
+        printf("\nInvalid choice.\n");
+        sleep_sec(1);
+        return;
+    }
+    getchar();
+    if (mode == 1) {
+        printf("Enter ID prefix: ");
+        fgets(range.low, 20, stdin);
+        range.low[strcspn(range.low, "\n")] = 0;
+        range.prefix_length = (int)strlen(range.low);
+        if (range.prefix_length == 0) {
+            printf("\nPrefix cannot be empty.\n");
+            sleep_sec(1);
+            return;
+        }
+        sprintf(title, "IDS STARTING WITH %s", range.low);
+    } else {
+        printf("Enter first ID: ");
+        fgets(range.low, 20, stdin);
+        range.low[strcspn(range.low, "\n")] = 0;
+        printf("Enter last ID: ");
+        fgets(range.high, 20, stdin);
+        range.high[strcspn(range.high, "\n")] = 0;
+        if (strcmp(range.low, range.high) > 0) {
+            printf("\nFirst ID must not come after last ID.\n");
+            sleep_sec(1);
+            return;
+        }
+        sprintf(title, "IDS FROM %s TO %s", range.low, range.high);
+    }
+    loadShardsInRange(&range);
+    int count = traverseRange(studentRoot, &range, visitors, 1);
+    displayHeader();
+    printf("\n%s\n", title);
+    printf("--------------------------------------------------\n");
+    printf("Matching Students: %d\n", count);
+    if (count == 0) {
+        printf("\nPress Enter to continue...");
+        getchar();
+        return;
+    }
+    printf("Admission Fees Paid: %.2f taka\n", fromPoisha(totals.admission) * admin_settings.display_multiplier);
+    printf("Tuition Fees Paid: %.2f taka\n", fromPoisha(totals.tuition) * admin_settings.display_multiplier);
+    printf("Total Paid: %.2f taka\n", fromPoisha(totals.admission + totals.tuition) * admin_settings.display_multiplier);
+    printf("Total Due: %.2f taka\n", fromPoisha(totals.due) * admin_settings.display_multiplier);
+    printf("Semester Payment Entries: %d\n", totals.entries);
+    printf("--------------------------------------------------\n");
+    printf("\nList matching students? (y/n): ");
+    scanf(" %c", &view_choice);
+    getchar();
+    if (tolower(view_choice) == 'y')
+        pageStudents(title, NULL, &range, count);
+}
+
 void updateStudentInfo() {
     char student_id[20];
     Student* student = NULL;
@@ -536,7 +2674,7 @@ void updateStudentInfo() {
     printf("Enter Student ID to update: ");
     fgets(student_id, 20, stdin);
     student_id[strcspn(student_id, "\n")] = 0;
-    student = bstSearch(studentRoot, student_id);
+    student = findStudent(student_id);
     if (student == NULL) {
         printf("\nNo student found with that ID.\n");
         sleep_sec(1);
@@ -564,8 +2702,10 @@ void updateStudentInfo() {
             printf("Enter New Name: ");
             fgets(new_name, MAX_NAME_LENGTH, stdin);
             new_name[strcspn(new_name, "\n")] = 0;
+            nameIndexRemove(student);
             strcpy(student->name, new_name);
-            getCurrentDateTime(student->last_updated);
+            nameIndexAdd(student);
+            student->updated_time = currentTimestamp();
             printf("\nName updated successfully!\n");
             break;
         case 2:
@@ -574,7 +2714,7 @@ void updateStudentInfo() {
             fgets(new_department, MAX_DEPT_LENGTH, stdin);
             new_department[strcspn(new_department, "\n")] = 0;
             strcpy(student->department, new_department);
-            getCurrentDateTime(student->last_updated);
+            student->updated_time = currentTimestamp();
             printf("\nDepartment updated successfully!\n");
             break;
         case 3:
@@ -584,7 +2724,7 @@ void updateStudentInfo() {
             scanf(" %c", &admission_choice);
             getchar();
             student->admission_fee_paid = (tolower(admission_choice) == 'y') ? admin_settings.admission_fee : 0;
-            getCurrentDateTime(student->last_updated);
+            student->updated_time = currentTimestamp();
             printf("\nAdmission fee status updated successfully!\n");
             break;
         case 4:
@@ -593,6 +2733,7 @@ void updateStudentInfo() {
             printf("\nInvalid choice.\n");
             break;
     }
+    markShardDirty(student->student_id);
     sleep_sec(1);
     saveData();
 }
@@ -606,7 +2747,7 @@ void deleteStudent() {
     printf("Enter Student ID to delete: ");
     fgets(student_id, 20, stdin);
     student_id[strcspn(student_id, "\n")] = 0;
-    Student* target = bstSearch(studentRoot, student_id);
+    Student* target = findStudent(student_id);
     if (target != NULL) {
         displayStudentInfo(target);
         printf("\nAre you sure you want to delete this student? (y/n): ");
@@ -617,9 +2758,18 @@ void deleteStudent() {
             while (p != NULL) {
                 PaymentNode* temp = p;
                 p = p->next;
-                free(temp);
+                ledgerRecord(temp->semester, paymentAmount(temp), -1);
+                columnsRemove(temp);
+                poolFree(&payment_pool, temp);
             }
+            indexRemove(student_id);
+            nameIndexRemove(target);
             studentRoot = bstDelete(studentRoot, student_id);
+            student_bloom.removed++;
+            bloomMaintain();
+            Shard* shard = shardForStudent(student_id, 1);
+            shard->student_count--;
+            shard->dirty = 1;
             printf("\nStudent deleted successfully!\n");
             saveData();
         } else {
@@ -645,7 +2795,7 @@ void makeSemesterPayment(Student* student) {
     if (student->payments != NULL) {
         ptr = student->payments;
         while (ptr != NULL) {
-            printf("Semester %d: %.2f taka\n", ptr->semester, ptr->amount_paid);
+            printf("Semester %d: %.2f taka\n", ptr->semester, fromPoisha(paymentAmount(ptr)));
             ptr = ptr->next;
         }
     } else {
@@ -682,7 +2832,7 @@ void makeSemesterPayment(Student* student) {
         ptr = ptr->next;
     }
     if (target != NULL) {
-        printf("\nWarning: Payment for Semester %d already exists (%.2f taka).\n", semester, target->amount_paid);
+        printf("\nWarning: Payment for Semester %d already exists (%.2f taka).\n", semester, fromPoisha(paymentAmount(target)));
         printf("Do you want to overwrite? (y/n): ");
         scanf(" %c", &overwrite);
         getchar();
@@ -713,9 +2863,13 @@ void makeSemesterPayment(Student* student) {
         break;
     }
     if (target != NULL) {
-        target->amount_paid = payment;
+        ledgerRecord(semester, paymentAmount(target), -1);
+        payment_columns.amount[target->row] = toPoisha(payment);
+        ledgerRecord(semester, paymentAmount(target), 1);
     } else {
         PaymentNode* new_payment = createPaymentNode(semester, payment);
+        ledgerRecord(semester, paymentAmount(new_payment), 1);
+        student->payment_count++;
         if (student->payments == NULL) {
             student->payments = new_payment;
         } else {
@@ -726,7 +2880,8 @@ void makeSemesterPayment(Student* student) {
             ptr->next = new_payment;
         }
     }
-    getCurrentDateTime(student->last_updated);
+    student->updated_time = currentTimestamp();
+    markShardDirty(student->student_id);
     printf("\nPayment recorded successfully!\n");
     sleep_sec(1);
     float total_paid = calculateTotalPaid(student);
@@ -750,8 +2905,9 @@ void modifyFeeSettings() {
     printf("Current Admission Fee: %.2f taka\n", admin_settings.admission_fee);
     printf("\n1. Change Tuition Fee\n");
     printf("2. Change Admission Fee\n");
-    printf("3. Return to Admin Menu\n");
-    printf("\nEnter your choice (1-3): ");
+    printf("3. Simulate Fee Change (What-If)\n");
+    printf("4. Return to Admin Menu\n");
+    printf("\nEnter your choice (1-4): ");
     if (scanf("%d", &choice) != 1) {
         while(getchar()!='\n');
         return;
@@ -764,6 +2920,7 @@ void modifyFeeSettings() {
                 printf("\nInvalid amount. Fee not updated.\n");
             } else {
                 admin_settings.tuition_fee = new_fee;
+                rebuildLedgers();
                 printf("\nTuition Fee updated to %.2f taka\n", new_fee);
                 saveData();
             }
@@ -781,6 +2938,9 @@ void modifyFeeSettings() {
             getchar();
             break;
         case 3:
+            simulateFeeChange();
+            return;
+        case 4:
             return;
         default:
             printf("\nInvalid choice.\n");
@@ -789,6 +2949,215 @@ void modifyFeeSettings() {
     sleep_sec(1);
 }
 
+static int snapshotDepartment(FeeSnapshotSet* set, const char* department) {
+    for (int i = 0; i < set->department_count; i++) {
+        if (strcmp(set->departments[i], department) == 0)
+            return i;
+    }
+    if (set->department_count == set->department_capacity) {
+        int new_capacity = (set->department_capacity == 0) ? 16 : set->department_capacity * 2;
+        char (*grown)[MAX_DEPT_LENGTH] = realloc(set->departments, new_capacity * sizeof(*grown));
+        if (grown == NULL) {
+            perror("Failed to allocate department table");
+            exit(EXIT_FAILURE);
+        }
+        set->departments = grown;
+        set->department_capacity = new_capacity;
+    }
+    strcpy(set->departments[set->department_count], department);
+    return set->department_count++;
+}
+
+static void feeSnapshotVisitor(Student* student, void* context) {
+    FeeSnapshotSet* set = (FeeSnapshotSet*)context;
+    if (set->count == set->capacity) {
+        int new_capacity = (set->capacity == 0) ? 1024 : set->capacity * 2;
+        FeeSnapshot* grown = (FeeSnapshot*)realloc(set->records, new_capacity * sizeof(FeeSnapshot));
+        if (grown == NULL) {
+            perror("Failed to allocate fee snapshot");
+            exit(EXIT_FAILURE);
+        }
+        set->records = grown;
+        set->capacity = new_capacity;
+    }
+    FeeSnapshot* record = &set->records[set->count++];
+    record->admission_paid = toPoisha(student->admission_fee_paid);
+    record->tuition_paid = 0;
+    record->max_semester = 0;
+    for (PaymentNode* p = student->payments; p != NULL; p = p->next) {
+        record->tuition_paid += paymentAmount(p);
+        if (p->semester > record->max_semester)
+            record->max_semester = p->semester;
+    }
+    record->department = snapshotDepartment(set, student->department);
+}
+
+static int dueBucket(long long due, long long tuition_fee) {
+    if (due <= 0)
+        return 0;
+    if (tuition_fee <= 0)
+        return DUE_BUCKET_COUNT - 1;
+    if (due * 2 < tuition_fee)
+        return 1;
+    if (due < tuition_fee)
+        return 2;
+    if (due < tuition_fee * 2)
+        return 3;
+    if (due < tuition_fee * 4)
+        return 4;
+    return 5;
+}
+
+static void feeSnapshotWorker(void* arg) {
+    FeeSimulationTask* task = (FeeSimulationTask*)arg;
+    for (int i = task->begin; i < task->end; i++)
+        feeSnapshotVisitor(task->students[i], &task->snapshot);
+}
+
+static void feeSimulationWorker(void* arg) {
+    FeeSimulationTask* task = (FeeSimulationTask*)arg;
+    for (int i = task->begin; i < task->end; i++) {
+        const FeeSnapshot* record = &task->records[i];
+        int department = task->department_map[record->department];
+        long long paid = record->admission_paid + record->tuition_paid;
+        long long current = record->max_semester * task->current_tuition + task->current_admission - paid;
+        long long projected = record->max_semester * task->tuition_fee + task->admission_fee - paid;
+        if (current > 0) {
+            task->current_total += current;
+            task->department_current[department] += current;
+        }
+        if (projected > 0) {
+            task->projected_total += projected;
+            task->department_projected[department] += projected;
+        }
+        task->due_buckets[dueBucket(projected, task->tuition_fee)]++;
+    }
+}
+
+void simulateFeeChange() {
+    static const char* bucket_labels[DUE_BUCKET_COUNT] = {
+        "No due", "Under 1/2 semester", "1/2 to 1 semester",
+        "1 to 2 semesters", "2 to 4 semesters", "4+ semesters"
+    };
+    float new_tuition, new_admission;
+    char apply_choice;
+    printf("\nEnter proposed Tuition Fee (current %.2f): ", admin_settings.tuition_fee);
+    if (scanf("%f", &new_tuition) != 1 || new_tuition < 0) {
+        printf("\nInvalid amount. Simulation cancelled.\n");
+        while (getchar() != '\n');
+        sleep_sec(1);
+        return;
+    }
+    printf("Enter proposed Admission Fee (current %.2f): ", admin_settings.admission_fee);
+    if (scanf("%f", &new_admission) != 1 || new_admission < 0) {
+        printf("\nInvalid amount. Simulation cancelled.\n");
+        while (getchar() != '\n');
+        sleep_sec(1);
+        return;
+    }
+    getchar();
+    loadAllShards();
+    FeeSnapshotSet set;
+    memset(&set, 0, sizeof(set));
+    Student** students = (Student**)malloc((student_pool.live_nodes + 1) * sizeof(Student*));
+    set.records = (FeeSnapshot*)malloc((student_pool.live_nodes + 1) * sizeof(FeeSnapshot));
+    if (students == NULL || set.records == NULL) {
+        perror("Failed to allocate fee snapshot");
+        exit(EXIT_FAILURE);
+    }
+    collectInorder(studentRoot, students, &set.count);
+    int workers = workersFor(set.count);
+    FeeSimulationTask tasks[MAX_WORKER_THREADS];
+    for (int i = 0; i < workers; i++) {
+        memset(&tasks[i], 0, sizeof(FeeSimulationTask));
+        tasks[i].students = students;
+        tasks[i].records = set.records;
+        tasks[i].begin = (int)((long long)set.count * i / workers);
+        tasks[i].end = (int)((long long)set.count * (i + 1) / workers);
+        tasks[i].snapshot.records = set.records + tasks[i].begin;
+        tasks[i].snapshot.capacity = tasks[i].end - tasks[i].begin;
+    }
+    runParallel(feeSnapshotWorker, tasks, sizeof(FeeSimulationTask), workers);
+    free(students);
+    for (int i = 0; i < workers; i++) {
+        FeeSnapshotSet* local = &tasks[i].snapshot;
+        tasks[i].department_map = (int*)malloc((local->department_count + 1) * sizeof(int));
+        if (tasks[i].department_map == NULL) {
+            perror("Failed to allocate department table");
+            exit(EXIT_FAILURE);
+        }
+        for (int d = 0; d < local->department_count; d++)
+            tasks[i].department_map[d] = snapshotDepartment(&set, local->departments[d]);
+        free(local->departments);
+    }
+    int departments = (set.department_count > 0) ? set.department_count : 1;
+    long long* sums = (long long*)calloc((size_t)workers * departments * 2, sizeof(long long));
+    if (sums == NULL) {
+        perror("Failed to allocate simulation totals");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < workers; i++) {
+        tasks[i].current_tuition = toPoisha(admin_settings.tuition_fee);
+        tasks[i].current_admission = toPoisha(admin_settings.admission_fee);
+        tasks[i].tuition_fee = toPoisha(new_tuition);
+        tasks[i].admission_fee = toPoisha(new_admission);
+        tasks[i].department_current = sums + (size_t)i * departments * 2;
+        tasks[i].department_projected = tasks[i].department_current + departments;
+    }
+    runParallel(feeSimulationWorker, tasks, sizeof(FeeSimulationTask), workers);
+    for (int i = 1; i < workers; i++) {
+        tasks[0].current_total += tasks[i].current_total;
+        tasks[0].projected_total += tasks[i].projected_total;
+        for (int d = 0; d < departments; d++) {
+            tasks[0].department_current[d] += tasks[i].department_current[d];
+            tasks[0].department_projected[d] += tasks[i].department_projected[d];
+        }
+        for (int b = 0; b < DUE_BUCKET_COUNT; b++)
+            tasks[0].due_buckets[b] += tasks[i].due_buckets[b];
+    }
+    float multiplier = admin_settings.display_multiplier;
+    displayHeader();
+    printf("\nFEE CHANGE SIMULATION\n");
+    printf("--------------------------------------------------\n");
+    printf("Tuition Fee: %.2f -> %.2f taka\n", admin_settings.tuition_fee, new_tuition);
+    printf("Admission Fee: %.2f -> %.2f taka\n", admin_settings.admission_fee, new_admission);
+    printf("Students Evaluated: %d (using %d worker thread%s)\n", set.count, workers, workers == 1 ? "" : "s");
+    printf("\nCurrent Total Receivables: %.2f taka\n", fromPoisha(tasks[0].current_total) * multiplier);
+    printf("Projected Total Receivables: %.2f taka\n", fromPoisha(tasks[0].projected_total) * multiplier);
+    printf("Change: %+.2f taka\n", fromPoisha(tasks[0].projected_total - tasks[0].current_total) * multiplier);
+    printf("\n%-20s %-18s %-18s %-18s\n", "Department", "Current Due", "Projected Due", "Change");
+    printf("-----------------------------------------------------------------------\n");
+    for (int d = 0; d < set.department_count; d++) {
+        printf("%-20s %-18.2f %-18.2f %+.2f\n", set.departments[d],
+               fromPoisha(tasks[0].department_current[d]) * multiplier,
+               fromPoisha(tasks[0].department_projected[d]) * multiplier,
+               fromPoisha(tasks[0].department_projected[d] - tasks[0].department_current[d]) * multiplier);
+    }
+    printf("\nProjected Due Distribution:\n");
+    for (int b = 0; b < DUE_BUCKET_COUNT; b++) {
+        printf("  %-20s %d\n", bucket_labels[b], tasks[0].due_buckets[b]);
+    }
+    for (int i = 0; i < workers; i++)
+        free(tasks[i].department_map);
+    free(sums);
+    free(set.records);
+    free(set.departments);
+    printf("--------------------------------------------------\n");
+    printf("\nApply these fee settings? (y/n): ");
+    scanf(" %c", &apply_choice);
+    getchar();
+    if (tolower(apply_choice) == 'y') {
+        admin_settings.tuition_fee = new_tuition;
+        admin_settings.admission_fee = new_admission;
+        rebuildLedgers();
+        printf("\nFee settings updated.\n");
+        saveData();
+    } else {
+        printf("\nFee settings unchanged.\n");
+        sleep_sec(1);
+    }
+}
+
 void modifyDisplayMultiplier() {
     float new_multiplier;
     displayHeader();
@@ -808,28 +3177,16 @@ void modifyDisplayMultiplier() {
 }
 
 float calculateTotalPaid(Student* student) {
-    float semester_total = 0.0f;
-    PaymentNode* ptr = student->payments;
-    while (ptr != NULL) {
-        semester_total += ptr->amount_paid;
-        ptr = ptr->next;
-    }
-    return student->admission_fee_paid + semester_total;
+    return (float)fromPoisha(studentPaidPoisha(student));
 }
 
 float calculateDue(Student* student) {
-    int max_semester = 0;
-    PaymentNode* ptr = student->payments;
-    while (ptr != NULL) {
-        if (ptr->semester > max_semester)
-            max_semester = ptr->semester;
-        ptr = ptr->next;
-    }
-    float total_expected = (max_semester * admin_settings.tuition_fee) + admin_settings.admission_fee;
-    return total_expected - calculateTotalPaid(student);
+    return (float)fromPoisha(studentDuePoisha(student));
 }
 
 void displayStudentInfo(Student* student) {
+    char created[MAX_DATE_LENGTH];
+    char updated[MAX_DATE_LENGTH];
     clearScreen();
     printf("\n==================================================\n");
     printf("STUDENT INFORMATION - ID: %s\n", student->student_id);
@@ -845,7 +3202,7 @@ void displayStudentInfo(Student* student) {
         while (ptr != NULL) {
             printf("  Semester %d: %.2f taka of %.2f taka\n", 
                    ptr->semester, 
-                   ptr->amount_paid * admin_settings.display_multiplier,
+                   fromPoisha(paymentAmount(ptr)) * admin_settings.display_multiplier,
                    admin_settings.tuition_fee * admin_settings.display_multiplier);
             ptr = ptr->next;
         }
@@ -855,16 +3212,20 @@ void displayStudentInfo(Student* student) {
     printf("\nPayment Summary:\n");
     printf("Total Paid: %.2f taka\n", calculateTotalPaid(student) * admin_settings.display_multiplier);
     printf("Total Due: %.2f taka\n", calculateDue(student) * admin_settings.display_multiplier);
-    printf("\nCreated on: %s\n", student->created_date);
-    printf("Last updated: %s\n", student->last_updated);
+    formatDateTime(student->created_time, created);
+    formatDateTime(student->updated_time, updated);
+    printf("\nCreated on: %s\n", created);
+    printf("Last updated: %s\n", updated);
     printf("==================================================\n");
     printf("\nPress Enter to continue...");
     getchar();
 }
 
 void displayTotalAmountPaid() {
-    float total_admission = 0.0f, total_tuition = 0.0f;
-    int total_semester_entries = 0;
+    long long admission = 0;
+    int count = 0;
+    VisitorBinding visitors[2] = {{admissionVisitor, &admission}, {countVisitor, &count}};
+    loadAllShards();
     displayHeader();
     printf("\nTOTAL AMOUNT PAID SUMMARY\n");
     printf("--------------------------------------------------\n");
@@ -874,81 +3235,239 @@ void displayTotalAmountPaid() {
         getchar();
         return;
     }
-    inorderAccumTotals(studentRoot, &total_admission, &total_tuition, &total_semester_entries);
-    float grand_total = total_admission + total_tuition;
-    int count = bstCountNodes(studentRoot);
+    traverseStudents(studentRoot, visitors, 2);
+    long long tuition = sumPoisha(payment_columns.amount, payment_columns.count);
+    size_t partial = countBelowPoisha(payment_columns.amount, payment_columns.count, toPoisha(admin_settings.tuition_fee));
     printf("Total Students: %d\n", count);
-    printf("Total Admission Fees Paid: %.2f taka\n", total_admission * admin_settings.display_multiplier);
-    printf("Total Tuition Fees Paid: %.2f taka\n", total_tuition * admin_settings.display_multiplier);
-    printf("Grand Total (Admission + Tuition): %.2f taka\n", grand_total * admin_settings.display_multiplier);
-    printf("Total Semester Payment Entries: %d\n", total_semester_entries);
+    printf("Total Admission Fees Paid: %.2f taka\n", fromPoisha(admission) * admin_settings.display_multiplier);
+    printf("Total Tuition Fees Paid: %.2f taka\n", fromPoisha(tuition) * admin_settings.display_multiplier);
+    printf("Grand Total (Admission + Tuition): %.2f taka\n", fromPoisha(admission + tuition) * admin_settings.display_multiplier);
+    printf("Total Semester Payment Entries: %zu\n", payment_columns.count);
+    printf("Partial Semester Payments: %zu\n", partial);
+    printf("--------------------------------------------------\n");
+    printf("\nPress Enter to continue...");
+    getchar();
+}
+
+void displaySemesterCollection() {
+    int semesters_shown = 0;
+    if (!ledger_complete)
+        rebuildLedgers();
+    displayHeader();
+    printf("\nSEMESTER COLLECTION REPORT\n");
+    printf("--------------------------------------------------\n");
+    printf("Tuition Fee per Semester: %.2f taka\n\n", admin_settings.tuition_fee * admin_settings.display_multiplier);
+    printf("%-10s %-10s %-20s %-8s %-8s\n", "Semester", "Payments", "Collected", "Full", "Partial");
+    printf("-----------------------------------------------------------------------\n");
+    for (int i = 1; i < ledger_capacity; i++) {
+        SemesterLedger* entry = &semester_ledger[i];
+        if (entry->payment_count == 0)
+            continue;
+        printf("%-10d %-10d %-14.2f taka  %-8d %-8d\n", i, entry->payment_count,
+               fromPoisha(entry->amount_total) * admin_settings.display_multiplier,
+               entry->full_count, entry->partial_count);
+        semesters_shown++;
+    }
+    if (semesters_shown == 0)
+        printf("No semester payments recorded yet.\n");
+    printf("--------------------------------------------------\n");
+    printf("\nPress Enter to continue...");
+    getchar();
+}
+
+static void printMemoryUsage() {
+    size_t student_bytes = student_pool.live_nodes * sizeof(Student);
+    size_t payment_bytes = payment_pool.live_nodes * sizeof(PaymentNode);
+    size_t reserved = poolReservedBytes(&student_pool) + poolReservedBytes(&payment_pool);
+    size_t free_bytes = reserved - student_bytes - payment_bytes;
+    size_t overhead = poolOverheadBytes(&student_pool) + poolOverheadBytes(&payment_pool);
+    size_t bloom_bytes = (student_bloom.bit_count + 7) / 8;
+    size_t index_bytes = (student_index.current.capacity + student_index.draining.capacity) * sizeof(HashSlot);
+    size_t name_index_bytes = poolReservedBytes(&bk_node_pool) + poolReservedBytes(&name_ref_pool) +
+                              poolOverheadBytes(&bk_node_pool) + poolOverheadBytes(&name_ref_pool);
+    size_t column_bytes = payment_columns.capacity * (sizeof(int) + sizeof(long long) + sizeof(PaymentNode*));
+    size_t shard_table_bytes = 0;
+    for (int i = 0; i < shard_count; i++)
+        shard_table_bytes += (shards[i].filter_bits + 7) / 8 + shards[i].ledger_capacity * sizeof(SemesterLedger);
+    size_t tables = shard_capacity * sizeof(Shard) + shard_table_bytes + ledger_capacity * sizeof(SemesterLedger) + bloom_bytes +
+                    index_bytes + name_index_bytes + column_bytes;
+    size_t total = reserved + overhead + tables;
+    printf("Live Students: %zu (%zu bytes)\n", student_pool.live_nodes, student_bytes);
+    printf("Live Payments: %zu (%zu bytes)\n", payment_pool.live_nodes, payment_bytes);
+    printf("Pool Capacity: %zu bytes in %zu chunks\n", reserved, student_pool.chunk_count + payment_pool.chunk_count);
+    printf("Free Pool Slots: %zu bytes (%.1f%% fragmentation)\n", free_bytes,
+           reserved > 0 ? 100.0 * free_bytes / reserved : 0.0);
+    printf("Allocator Overhead: %zu bytes\n", overhead);
+    printf("Shard/Ledger/Bloom/Index Tables: %zu bytes (payment columns %zu)\n", tables, column_bytes);
+    if (name_index_built)
+        printf("Name Index: %zu keys (%d awaiting rebuild), %zu entries\n", nameIndexLiveKeys(),
+               name_index_dead_keys, name_ref_pool.live_nodes);
+    else
+        printf("Name Index: not built yet (built on first fuzzy search)\n");
+    printf("Total Footprint: %zu bytes\n", total);
+    printf("Bytes per Student: %.1f\n",
+           student_pool.live_nodes > 0 ? (double)total / student_pool.live_nodes : 0.0);
+}
+
+int compactMemory() {
+    int count = bstCountNodes(studentRoot);
+    size_t payment_count = payment_pool.live_nodes;
+    Student** nodes = (Student**)malloc((count > 0 ? count : 1) * sizeof(Student*));
+    NodePool students = {sizeof(Student), NULL, NULL, 0, 0, 0};
+    NodePool payments = {sizeof(PaymentNode), NULL, NULL, 0, 0, 0};
+    if (nodes == NULL ||
+        (count > 0 && poolAddChunk(&students, count) == NULL) ||
+        (payment_count > 0 && poolAddChunk(&payments, payment_count) == NULL)) {
+        printf("\nError: Not enough memory to compact.\n");
+        free(nodes);
+        poolRelease(&students);
+        poolRelease(&payments);
+        return 0;
+    }
+    count = 0;
+    collectInorder(studentRoot, nodes, &count);
+    for (int i = 0; i < count; i++) {
+        Student* copy = (Student*)poolAlloc(&students);
+        *copy = *nodes[i];
+        PaymentNode** tail = &copy->payments;
+        for (PaymentNode* p = nodes[i]->payments; p != NULL; p = p->next) {
+            PaymentNode* payment = (PaymentNode*)poolAlloc(&payments);
+            *payment = *p;
+            payment_columns.owner[payment->row] = payment;
+            *tail = payment;
+            tail = &payment->next;
+        }
+        *tail = NULL;
+        nodes[i] = copy;
+    }
+    studentRoot = buildBalanced(nodes, 0, count);
+    indexReset(count);
+    visitStudents(studentRoot, indexVisitor, NULL);
+    if (name_index_built)
+        nameIndexRebuild();
+    poolRelease(&student_pool);
+    poolRelease(&payment_pool);
+    student_pool = students;
+    payment_pool = payments;
+    free(nodes);
+    return 1;
+}
+
+void displayMemoryDiagnostics() {
+    char compact_choice;
+    displayHeader();
+    printf("\nMEMORY DIAGNOSTICS\n");
+    printf("--------------------------------------------------\n");
+    printMemoryUsage();
     printf("--------------------------------------------------\n");
+    printf("ID Bloom Filter: %zu bytes, %d keys (%d deleted), %d hashes\n",
+           (student_bloom.bit_count + 7) / 8, student_bloom.keys, student_bloom.removed, BLOOM_HASHES);
+    printf("Estimated False-Positive Rate: %.4f%%\n", 100.0 * bloomEstimatedFalsePositiveRate());
+    printf("Lookups: %lld, Fast Rejects: %lld, False Positives: %lld (%.4f%% of misses)\n",
+           student_bloom.queries, student_bloom.rejects, student_bloom.false_positives,
+           (student_bloom.rejects + student_bloom.false_positives) > 0
+               ? 100.0 * student_bloom.false_positives / (student_bloom.rejects + student_bloom.false_positives)
+               : 0.0);
+    printf("ID Hash Index: %zu of %zu slots used (%.1f%% load), %lld resizes%s\n",
+           student_index.current.live, student_index.current.capacity,
+           student_index.current.capacity > 0 ? 100.0 * student_index.current.live / student_index.current.capacity : 0.0,
+           student_index.resizes, student_index.draining.slots != NULL ? ", resize in progress" : "");
+    printf("--------------------------------------------------\n");
+    printf("\nCompact memory now? (y/n): ");
+    scanf(" %c", &compact_choice);
+    getchar();
+    if (tolower(compact_choice) != 'y')
+        return;
+    if (compactMemory()) {
+        printf("\nAfter compaction:\n");
+        printMemoryUsage();
+    }
     printf("\nPress Enter to continue...");
     getchar();
 }
 
 void saveData() {
-    FILE* student_file = fopen("students.dat", "wb");
     FILE* settings_file = fopen("settings.dat", "wb");
-    if (student_file == NULL || settings_file == NULL) {
+    if (settings_file == NULL) {
         printf("\nError: Could not open files for saving data.\n");
         sleep_sec(1);
         return;
     }
-    int count = bstCountNodes(studentRoot);
-    fwrite(&count, sizeof(int), 1, student_file);
-    bstWriteStudentData(studentRoot, student_file);
+    if (!ledger_complete)
+        rebuildLedgers();
+    StudentList batch = {NULL, 0, 0};
+    int pending = 0;
+    for (int i = 0; i < shard_count; i++) {
+        if (shards[i].dirty && !shards[i].loaded) {
+            parseShard(&shards[i], &batch);
+            pending++;
+        }
+    }
+    if (pending > 0)
+        stitchBatch(&batch, 0);
+    for (int i = 0; i < shard_count; i++) {
+        if (!shards[i].dirty) {
+            if (shards[i].loaded && shards[i].filter == NULL)
+                shardFilterBuild(&shards[i]);
+            continue;
+        }
+        char file_name[32];
+        shardFileName(i, file_name);
+        FILE* student_file = fopen(file_name, "wb");
+        if (student_file == NULL) {
+            printf("\nError: Could not open files for saving data.\n");
+            fclose(settings_file);
+            sleep_sec(1);
+            return;
+        }
+        int magic = DATA_MAGIC, version = DATA_VERSION, count = 0, chunk_records = LOAD_CHUNK_RECORDS;
+        long long index_offset = 0;
+        ChunkIndex index = {NULL, 0, 0};
+        fwrite(&magic, sizeof(int), 1, student_file);
+        fwrite(&version, sizeof(int), 1, student_file);
+        long count_offset = ftell(student_file);
+        fwrite(&count, sizeof(int), 1, student_file);
+        fwrite(&chunk_records, sizeof(int), 1, student_file);
+        fwrite(&index_offset, sizeof(long long), 1, student_file);
+        count = writeShardRecords(&shards[i], student_file, &index);
+        index_offset = (long long)ftell(student_file);
+        fwrite(&index.count, sizeof(int), 1, student_file);
+        fwrite(index.offsets, sizeof(long long), index.count, student_file);
+        fseek(student_file, count_offset, SEEK_SET);
+        fwrite(&count, sizeof(int), 1, student_file);
+        fwrite(&chunk_records, sizeof(int), 1, student_file);
+        fwrite(&index_offset, sizeof(long long), 1, student_file);
+        fclose(student_file);
+        free(index.offsets);
+        shards[i].student_count = count;
+        shards[i].dirty = 0;
+    }
+    writeManifest();
+    char stale_file[32];
+    for (int i = shard_count;; i++) {
+        shardFileName(i, stale_file);
+        if (remove(stale_file) != 0)
+            break;
+    }
     fwrite(&admin_settings, sizeof(AdminSettings), 1, settings_file);
-    fclose(student_file);
     fclose(settings_file);
     printf("\nData saved successfully.\n");
     sleep_sec(1);
 }
 
 void loadData() {
-    FILE* student_file = fopen("students.dat", "rb");
     FILE* settings_file = fopen("settings.dat", "rb");
-    if (student_file != NULL) {
-        int count;
-        fread(&count, sizeof(int), 1, student_file);
-        for (int i = 0; i < count; i++) {
-            Student* new_student = (Student*)malloc(sizeof(Student));
-            if (!new_student) {
-                perror("Memory allocation error");
-                exit(EXIT_FAILURE);
-            }
-            fread(new_student->student_id, sizeof(char), 20, student_file);
-            fread(new_student->name, sizeof(char), MAX_NAME_LENGTH, student_file);
-            fread(new_student->department, sizeof(char), MAX_DEPT_LENGTH, student_file);
-            fread(&new_student->admission_fee_paid, sizeof(float), 1, student_file);
-            fread(new_student->created_date, sizeof(char), MAX_DATE_LENGTH, student_file);
-            fread(new_student->last_updated, sizeof(char), MAX_DATE_LENGTH, student_file);
-            new_student->payments = NULL;
-            new_student->left = new_student->right = NULL;
-            int payment_count;
-            fread(&payment_count, sizeof(int), 1, student_file);
-            PaymentNode* last_payment = NULL;
-            for (int j = 0; j < payment_count; j++) {
-                PaymentNode* new_payment = createPaymentNode(0, 0);
-                fread(&new_payment->semester, sizeof(int), 1, student_file);
-                fread(&new_payment->amount_paid, sizeof(float), 1, student_file);
-                new_payment->next = NULL;
-                if (new_student->payments == NULL) {
-                    new_student->payments = new_payment;
-                    last_payment = new_payment;
-                } else {
-                    last_payment->next = new_payment;
-                    last_payment = new_payment;
-                }
-            }
-            studentRoot = bstInsert(studentRoot, new_student);
-        }
-        fclose(student_file);
-    }
     if (settings_file != NULL) {
         fread(&admin_settings, sizeof(AdminSettings), 1, settings_file);
         fclose(settings_file);
     }
+    if (!readManifest()) {
+        loadStudentFile(LEGACY_STUDENT_FILE, 1);
+    } else {
+        bloomReset(totalStudentCount());
+        indexReset(totalStudentCount());
+        migrateShardPrefixes();
+    }
 }
 
 int main() {